@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <string>
+#include <utility>
 
 /**
  *	@brief Interface for playing a game interactively and with solver.
@@ -90,6 +91,14 @@ public:
 	 */
 	virtual uint8_t start_solver(std::function<void(const std::string&)> status_callback) = 0;
 
+	/**
+	 *	@brief Starts solving the current state on a background thread, so that start_solver() from the same state can adopt the result instead of solving again.
+	 *
+	 *	@details An unfinished background solve is cancelled by the next move. Does nothing in solver mode or if there already is a background solve.
+	 *	\p status_callback is called on the background thread.
+	 */
+	virtual void start_background_solver(std::function<void(const std::string&)> status_callback = nullptr) = 0;
+
 	/**
 	 *	@brief Resets game state to the state where the solver has been started. Does nothing if not in solver mode.
 	 */
@@ -123,6 +132,21 @@ public:
 	 */
 	virtual std::string svg(const tobor::v1_1::color_vector& current_color_vector, const tobor::v1_1::general_piece_shape_selection& shape = tobor::v1_1::general_piece_shape_selection::BALL) const = 0;
 
+	/**
+	 *	@brief Returns an svg of the game's board without pieces. It does not change during a game.
+	 */
+	virtual std::string svg_board(const tobor::v1_1::color_vector& current_color_vector) const = 0;
+
+	/**
+	 *	@brief Returns an svg of a single cell showing the piece with color id \p color_id.
+	 */
+	virtual std::string svg_piece(const tobor::v1_1::color_vector& current_color_vector, const std::size_t& color_id, const tobor::v1_1::general_piece_shape_selection& shape = tobor::v1_1::general_piece_shape_selection::BALL) const = 0;
+
+	/**
+	 *	@brief Returns the upper left corner of the piece with color id \p color_id in the coordinates of svg() and svg_board().
+	 */
+	virtual std::pair<double, double> svg_piece_position(const std::size_t& color_id) const = 0;
+
 	/**
 	 *	@brief Selects a piece by its id.
 	 *	@return Returns 2 in solver mode and does nothing
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "engine_typeset.h"
+#include "world_generator_1_1.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+*	@brief Immutable game board together with everything precomputed from it: the move engine including its quick_move_cache, and the target cells.
+*
+*	@details Neither copyable nor movable since the move engine refers to the world.
+*	Target cells are the cells recognized by original_4_of_16::get_target_cell_id_vector(), in that order.
+*/
+template<class Pieces_Quantity_T>
+class SharedBoard {
+public:
+
+	using engine_typeset = ClassicEngineTypeSet<Pieces_Quantity_T>;
+
+	using world_type = typename engine_typeset::world_type;
+	using cell_id_type = typename engine_typeset::cell_id_type;
+	using move_engine_type = typename engine_typeset::move_engine_type;
+
+private:
+
+	world_type _world;
+
+	move_engine_type _move_engine;
+
+	std::vector<cell_id_type> _target_cells;
+
+public:
+
+	SharedBoard(const world_type& world) :
+		_world(world),
+		_move_engine(_world),
+		_target_cells()
+	{
+		const auto raw_cell_ids{ tobor::v1_1::world_generator::original_4_of_16::get_target_cell_id_vector(_world) };
+		_target_cells.reserve(raw_cell_ids.size());
+		std::transform(raw_cell_ids.cbegin(), raw_cell_ids.cend(), std::back_inserter(_target_cells),
+			[&](const auto& raw_cell_id) {
+				return cell_id_type::create_by_id(raw_cell_id, _world);
+			}
+		);
+	}
+
+	SharedBoard(const SharedBoard&) = delete;
+
+	SharedBoard& operator=(const SharedBoard&) = delete;
+
+	inline const world_type& world() const noexcept { return _world; }
+
+	inline const move_engine_type& move_engine() const noexcept { return _move_engine; }
+
+	inline const std::vector<cell_id_type>& target_cells() const noexcept { return _target_cells; }
+
+};
+
+/**
+*	@brief Process-wide registry handing out one SharedBoard for all equal worlds. Thread-safe.
+*
+*	@details Boards are deduplicated by world_type::wall_hash() and world equality.
+*	The registry only holds weak references, a board lives as long as someone holds its shared pointer.
+*/
+template<class Pieces_Quantity_T>
+class BoardRegistry {
+public:
+
+	using shared_board_type = SharedBoard<Pieces_Quantity_T>;
+
+	using world_type = typename shared_board_type::world_type;
+
+private:
+
+	std::mutex _mutex;
+
+	std::unordered_multimap<uint64_t, std::weak_ptr<const shared_board_type>> _boards;
+
+	BoardRegistry() {}
+
+public:
+
+	BoardRegistry(const BoardRegistry&) = delete;
+
+	BoardRegistry& operator=(const BoardRegistry&) = delete;
+
+	/**
+	*	@brief Returns the process-wide registry.
+	*/
+	inline static BoardRegistry& instance() {
+		static BoardRegistry registry;
+		return registry;
+	}
+
+	/**
+	*	@brief Returns the shared board equal to \p world, creating it if there is none alive.
+	*/
+	std::shared_ptr<const shared_board_type> get(const world_type& world) {
+		const uint64_t hash{ world.wall_hash() };
+
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		const auto [first, last] = _boards.equal_range(hash);
+		for (auto iter = first; iter != last; ++iter) {
+			if (auto board = iter->second.lock()) {
+				if (board->world() == world) {
+					return board;
+				}
+			}
+		}
+
+		std::erase_if(_boards, [](const auto& entry) { return entry.second.expired(); });
+
+		auto board = std::make_shared<const shared_board_type>(world);
+		_boards.emplace(hash, board);
+		return board;
+	}
+
+	/**
+	*	@brief Returns the number of boards alive.
+	*/
+	std::size_t size() {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return static_cast<std::size_t>(std::count_if(_boards.cbegin(), _boards.cend(), [](const auto& entry) { return !entry.second.expired(); }));
+	}
+
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "engine_typeset.h"
+
+#include "models/direction.h"
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+
+/**
+*	@brief Turns games by multiples of 90 degrees, and selects a canonical rotation for each game.
+*
+*	@details A game turned left has the solutions of the original game turned left, i.e. the same moves with turned directions.
+*	So all rotations of a game can be solved as their canonical rotation.
+*	Rotation counts are numbers of left turns by 90 degrees, like in world_generator::original_4_of_16::get_world().
+*/
+template<class Pieces_Quantity_T>
+class BoardRotation {
+public:
+
+	using engine_typeset = ClassicEngineTypeSet<Pieces_Quantity_T>;
+
+	using world_type = typename engine_typeset::world_type;
+
+	using cell_id_type = typename engine_typeset::cell_id_type;
+
+	using positions_of_pieces_type_solver = typename engine_typeset::positions_of_pieces_type_solver;
+
+	using direction_type = tobor::v1_1::direction;
+
+	static constexpr uint8_t COUNT_ROTATIONS{ 4 };
+
+	/**
+	*	@brief Returns \p world turned left \p rotation times. Requires a quadratic world if \p rotation is not a multiple of COUNT_ROTATIONS.
+	*/
+	static world_type turned_world(const world_type& world, uint8_t rotation) {
+		rotation %= COUNT_ROTATIONS;
+		world_type result{ world };
+		while (rotation--) {
+			result = result.turn_left_90();
+		}
+		return result;
+	}
+
+	/**
+	*	@brief Returns the cell of the turned world which \p cell of \p world is turned to.
+	*/
+	static cell_id_type turned_cell(const cell_id_type& cell, const world_type& world, uint8_t rotation) {
+		rotation %= COUNT_ROTATIONS;
+		const auto LAST{ static_cast<typename cell_id_type::int_cell_id_type>(world.get_horizontal_size() - 1) };
+		auto x{ cell.get_x_coord(world) };
+		auto y{ cell.get_y_coord(world) };
+		while (rotation--) {
+			// turn_left_90() moves cell (x, y) to (LAST - y, x)
+			const auto x_turned{ static_cast<typename cell_id_type::int_cell_id_type>(LAST - y) };
+			y = x;
+			x = x_turned;
+		}
+		return cell_id_type::create_by_coordinates(x, y, world);
+	}
+
+	/**
+	*	@brief Returns \p cells with each cell turned, keeping the order of pieces.
+	*/
+	template<class Array_T>
+	static Array_T turned_cells(Array_T cells, const world_type& world, uint8_t rotation) {
+		for (auto& cell : cells) {
+			cell = turned_cell(cell, world, rotation);
+		}
+		return cells;
+	}
+
+	/**
+	*	@brief Returns the state of the turned world where each piece of \p state is turned.
+	*/
+	static positions_of_pieces_type_solver turned_state(const positions_of_pieces_type_solver& state, const world_type& world, uint8_t rotation) {
+		const auto cells{ turned_cells(state.piece_positions(), world, rotation) };
+		return positions_of_pieces_type_solver(cells.cbegin());
+	}
+
+	/**
+	*	@brief Returns \p dir turned left \p rotation times.
+	*/
+	static direction_type turned_direction(const direction_type& dir, uint8_t rotation) {
+		static const std::array<direction_type, COUNT_ROTATIONS> LEFT_TURN_ORDER{
+			direction_type::NORTH(), direction_type::WEST(), direction_type::SOUTH(), direction_type::EAST()
+		};
+		for (uint8_t i{ 0 }; i < COUNT_ROTATIONS; ++i) {
+			if (LEFT_TURN_ORDER[i] == dir) {
+				return LEFT_TURN_ORDER[(i + rotation) % COUNT_ROTATIONS];
+			}
+		}
+		return dir;
+	}
+
+	/**
+	*	@brief Returns the rotation which undoes \p rotation.
+	*/
+	inline static uint8_t inverse_rotation(uint8_t rotation) {
+		return static_cast<uint8_t>((COUNT_ROTATIONS - rotation % COUNT_ROTATIONS) % COUNT_ROTATIONS);
+	}
+
+	/**
+	*	@brief Returns the rotation which turns the game of \p world and \p initial_state into its canonical rotation.
+	*
+	*	@details The canonical rotation is the one with the least world_type::wall_hash(), on a tie the one with the least initial state.
+	*	All rotations of a game have the same canonical rotation, except for hash collisions of different worlds, which only cost a cache miss.
+	*	Non-quadratic worlds are not turned.
+	*/
+	static uint8_t canonical_rotation(const world_type& world, const positions_of_pieces_type_solver& initial_state) {
+		if (world.get_horizontal_size() != world.get_vertical_size()) {
+			return 0;
+		}
+
+		uint8_t best{ 0 };
+		auto best_key{ std::make_tuple(world.wall_hash(), initial_state) };
+
+		world_type turned{ world };
+		for (uint8_t rotation{ 1 }; rotation < COUNT_ROTATIONS; ++rotation) {
+			turned = turned.turn_left_90();
+			const auto key{ std::make_tuple(turned.wall_hash(), turned_state(initial_state, world, rotation)) };
+			if (key < best_key) {
+				best = rotation;
+				best_key = key;
+			}
+		}
+		return best;
+	}
+};
@@ -22,6 +22,27 @@ cli_config parse_cli(int argc, char** argv) {
 		config.log_file = true;
 	});
 
+	// --build-difficulty-index path [--difficulty-index-samples n] [--difficulty-index-seed s] [--difficulty-index-max-depth d]
+	app.add_option("--build-difficulty-index", config.difficulty_index_path, "Solve sampled games and write a difficulty index to the given path, then exit");
+	app.add_option("--difficulty-index-samples", config.difficulty_index_samples, "Number of sampled games for the difficulty index");
+	app.add_option("--difficulty-index-seed", config.difficulty_index_seed, "Seed for sampling the games of the difficulty index");
+	app.add_option("--difficulty-index-max-depth", config.difficulty_index_max_depth, "Maximum optimal solution length of games in the difficulty index");
+
+	// --serve | --serve-socket path [--serve-threads n]
+	app.add_flag("--serve", config.serve_stdio, "Run the solver daemon, reading JSON requests from stdin and writing JSON responses to stdout");
+	app.add_option("--serve-socket", config.serve_socket_path, "Run the solver daemon on a Unix domain socket at the given path");
+	app.add_option("--serve-threads", config.serve_threads, "Number of solver threads of the solver daemon (default: one per hardware thread)");
+
+	// --benchmark-engines | --benchmark-svg [--benchmark-world n] [--benchmark-state n] [--benchmark-repetitions n]
+	app.add_flag("--benchmark-engines", config.benchmark_engines, "Solve one original game with 8 bit and 16 bit cell id engines, print memory and throughput, then exit");
+	app.add_flag("--benchmark-svg", config.benchmark_svg, "Render one original game as full-board SVG with each piece shape, print document size and rendering time, then exit");
+	app.add_option("--benchmark-world", config.benchmark_world_counter, "World generator counter of the benchmark game");
+	app.add_option("--benchmark-state", config.benchmark_state_counter, "State generator counter of the benchmark game");
+	app.add_option("--benchmark-repetitions", config.benchmark_repetitions, "Number of runs per engine or piece shape, the fastest one is reported");
+
+	// --trace-file path
+	app.add_option("--trace-file", config.trace_file_path, "Write recorded trace events as Chrome trace JSON to the given path on exit (requires a build with TOBOR_TRACE_ENABLE)");
+
 	try {
 		app.parse(argc, argv);
 	} catch (const CLI::ParseError& e) {
@@ -6,6 +6,7 @@ TODO: check / implement correct handling of each cli_config member
 
 #include <CLI/CLI.hpp>
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 
@@ -17,6 +18,23 @@ struct cli_config {
 	bool        log_console{ false }; ///< enables logging to console window
 	bool        log_file{ false };     ///< enables logging to file
 	std::string log_file_path{};      ///< path to log file where to write log or empty in case a default file location should be used
+
+	std::string difficulty_index_path{};               ///< if not empty, builds a difficulty index at this path instead of starting the gui
+	std::size_t difficulty_index_samples{ 10000 };     ///< number of randomly sampled games to be solved for the difficulty index
+	uint64_t    difficulty_index_seed{ 0 };            ///< seed for sampling the games of the difficulty index
+	std::size_t difficulty_index_max_depth{ 16 };      ///< games with longer optimal solutions are not put into the difficulty index
+
+	bool        serve_stdio{ false };                  ///< runs the solver daemon on stdin / stdout instead of starting the gui
+	std::string serve_socket_path{};                   ///< if not empty, runs the solver daemon on a Unix domain socket at this path instead of starting the gui
+	std::size_t serve_threads{ 0 };                    ///< number of solver threads of the solver daemon, 0 for one per hardware thread
+
+	bool        benchmark_engines{ false };            ///< compares the 8 bit and 16 bit cell id engine type sets on one original game instead of starting the gui
+	bool        benchmark_svg{ false };                ///< measures full-board SVG rendering of one original game instead of starting the gui
+	uint64_t    benchmark_world_counter{ 5 };          ///< world generator counter of the benchmark game
+	uint64_t    benchmark_state_counter{ 8793 };       ///< state generator counter of the benchmark game
+	std::size_t benchmark_repetitions{ 5 };            ///< number of runs per engine type set or piece shape, the fastest one is reported
+
+	std::string trace_file_path{};                     ///< if not empty, writes the recorded trace events as Chrome trace JSON to this path on exit
 };
 
 /**
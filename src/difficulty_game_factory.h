@@ -0,0 +1,82 @@
+#pragma once
+
+#include "original_game_factory.h"
+#include "difficulty_index.h"
+
+#include <memory>
+#include <stdexcept>
+
+/**
+*	@brief Factory to create original games with a requested optimal solution length, looked up in a DifficultyIndex.
+*
+*	@details Incrementing steps through all games of that length in the index.
+*/
+template<class Pieces_Quantity_Type>
+class DifficultyGameFactory : public OriginalGameFactory<Pieces_Quantity_Type> {
+public:
+
+	using base_type = OriginalGameFactory<Pieces_Quantity_Type>;
+
+	using pieces_quantity_type = Pieces_Quantity_Type;
+
+private:
+
+	std::shared_ptr<const DifficultyIndex> _index;
+
+	std::size_t _optimal_length;
+
+	/** Position of the current game among all games of _optimal_length */
+	std::size_t _position;
+
+	void select_current_game() {
+		const DifficultyIndex::game g{ _index->get(_optimal_length, _position) };
+		base_type::set_world_generator_counter(static_cast<std::size_t>(g.world_generator_counter));
+		base_type::set_state_generator_counter(static_cast<std::size_t>(g.state_generator_counter));
+	}
+
+public:
+
+	/**
+	*	@brief Selects the games of \p index with the optimal solution length closest to \p requested_length, starting at \p position.
+	*
+	*	@details Throws std::invalid_argument if \p index was built for another pieces quantity or contains no games.
+	*/
+	DifficultyGameFactory(const std::shared_ptr<const DifficultyIndex>& index, const std::size_t& requested_length, const std::size_t& position = 0) :
+		base_type(),
+		_index(index),
+		_optimal_length(0),
+		_position(0)
+	{
+		if (
+			_index->count_target_pieces() != pieces_quantity_type::COUNT_TARGET_PIECES ||
+			_index->count_non_target_pieces() != pieces_quantity_type::COUNT_NON_TARGET_PIECES
+			) {
+			throw std::invalid_argument("Difficulty index was built for another number of pieces.");
+		}
+
+		_optimal_length = _index->nearest_length(requested_length);
+
+		if (_index->count_games(_optimal_length) == 0) {
+			throw std::invalid_argument("Difficulty index contains no games.");
+		}
+
+		_position = position % _index->count_games(_optimal_length);
+		select_current_game();
+	}
+
+	DifficultyGameFactory(const DifficultyGameFactory&) = default;
+
+	/**
+	*	@brief Returns the optimal solution length of the games created.
+	*/
+	inline std::size_t optimal_length() const noexcept { return _optimal_length; }
+
+	virtual void increment() override {
+		_position = (_position + 1) % _index->count_games(_optimal_length);
+		select_current_game();
+	}
+
+	[[nodiscard]] virtual DifficultyGameFactory* clone() const override { return new DifficultyGameFactory(*this); }
+
+	virtual ~DifficultyGameFactory() override {}
+};
@@ -0,0 +1,391 @@
+#pragma once
+
+#include "board_registry.h"
+#include "board_rotation.h"
+#include "memory_mapped_file.h"
+
+#include "engine/distance_exploration.h"
+#include "engine/parallel_algorithms.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+*	@brief Read-only, memory-mapped index from optimal solution length to games, given by their generator counters.
+*
+*	@details File layout, all integers in native byte order:
+*	header, uint64_t offsets[count_lengths + 1], uint32_t world_counters[count_games] (zero padded to a multiple of 8 bytes), uint64_t state_counters[count_games].
+*	The games of optimal length l are those at the positions [offsets[l], offsets[l + 1]).
+*/
+class DifficultyIndex {
+public:
+
+	struct header {
+		char magic[8];
+		uint32_t version;
+		uint32_t count_target_pieces;
+		uint32_t count_non_target_pieces;
+		uint32_t count_lengths;
+	};
+
+	/**
+	*	@brief A game, identified by the counters of world generator and state generator.
+	*/
+	struct game {
+		uint64_t world_generator_counter;
+		uint64_t state_generator_counter;
+	};
+
+	static constexpr char MAGIC[8]{ 'T', 'O', 'B', 'O', 'R', 'D', 'I', 'X' };
+
+	static constexpr uint32_t VERSION{ 1 };
+
+private:
+
+	MemoryMappedFile _file;
+
+	header _header;
+
+	const uint64_t* _offsets;
+
+	const uint32_t* _world_counters;
+
+	const uint64_t* _state_counters;
+
+	inline static std::size_t padded_to_8(const std::size_t& bytes) { return (bytes + 7) / 8 * 8; }
+
+public:
+
+	/**
+	*	@brief Maps the index file at \p path. Throws std::runtime_error if it is no valid index file.
+	*/
+	explicit DifficultyIndex(const std::string& path) : _file(path), _header(), _offsets(nullptr), _world_counters(nullptr), _state_counters(nullptr) {
+		if (_file.size() < sizeof(header)) {
+			throw std::runtime_error("Invalid difficulty index file " + path);
+		}
+		std::memcpy(&_header, _file.data(), sizeof(header));
+
+		if (std::memcmp(_header.magic, MAGIC, sizeof(MAGIC)) != 0 || _header.version != VERSION) {
+			throw std::runtime_error("Invalid difficulty index file " + path);
+		}
+
+		const std::size_t offsets_position{ sizeof(header) };
+		const std::size_t offsets_bytes{ (std::size_t(_header.count_lengths) + 1) * sizeof(uint64_t) };
+		if (_file.size() < offsets_position + offsets_bytes) {
+			throw std::runtime_error("Invalid difficulty index file " + path);
+		}
+		_offsets = reinterpret_cast<const uint64_t*>(_file.data() + offsets_position);
+
+		const std::size_t COUNT_GAMES{ static_cast<std::size_t>(_offsets[_header.count_lengths]) };
+		const std::size_t world_counters_position{ offsets_position + offsets_bytes };
+		const std::size_t state_counters_position{ world_counters_position + padded_to_8(COUNT_GAMES * sizeof(uint32_t)) };
+		if (_file.size() != state_counters_position + COUNT_GAMES * sizeof(uint64_t)) {
+			throw std::runtime_error("Invalid difficulty index file " + path);
+		}
+		_world_counters = reinterpret_cast<const uint32_t*>(_file.data() + world_counters_position);
+		_state_counters = reinterpret_cast<const uint64_t*>(_file.data() + state_counters_position);
+	}
+
+	inline std::size_t count_target_pieces() const noexcept { return _header.count_target_pieces; }
+
+	inline std::size_t count_non_target_pieces() const noexcept { return _header.count_non_target_pieces; }
+
+	/**
+	*	@brief Returns the greatest optimal length contained plus one.
+	*/
+	inline std::size_t count_lengths() const noexcept { return _header.count_lengths; }
+
+	/**
+	*	@brief Returns the number of games with optimal solution length \p optimal_length.
+	*/
+	inline std::size_t count_games(const std::size_t& optimal_length) const noexcept {
+		if (!(optimal_length < count_lengths())) {
+			return 0;
+		}
+		return static_cast<std::size_t>(_offsets[optimal_length + 1] - _offsets[optimal_length]);
+	}
+
+	/**
+	*	@brief Returns the number of all games in the index.
+	*/
+	inline std::size_t count_games() const noexcept { return static_cast<std::size_t>(_offsets[count_lengths()]); }
+
+	/**
+	*	@brief Returns the \p position -th game with optimal solution length \p optimal_length.
+	*	@details Requires position < count_games(optimal_length).
+	*/
+	inline game get(const std::size_t& optimal_length, const std::size_t& position) const noexcept {
+		const std::size_t i{ static_cast<std::size_t>(_offsets[optimal_length]) + position };
+		return game{ _world_counters[i], _state_counters[i] };
+	}
+
+	/**
+	*	@brief Returns the optimal length closest to \p requested_length which has games, preferring the smaller one on a tie.
+	*	Returns count_lengths() if the index is empty.
+	*/
+	inline std::size_t nearest_length(const std::size_t& requested_length) const noexcept {
+		std::size_t best{ count_lengths() };
+		std::size_t best_distance{ std::numeric_limits<std::size_t>::max() };
+		for (std::size_t length{ 0 }; length < count_lengths(); ++length) {
+			if (count_games(length) == 0) continue;
+			const std::size_t distance{ length < requested_length ? requested_length - length : length - requested_length };
+			if (distance < best_distance) {
+				best = length;
+				best_distance = distance;
+			}
+		}
+		return best;
+	}
+
+	/**
+	*	@brief Writes an index file to \p path containing each game of \p games with its optimal length at the same position of \p optimal_lengths.
+	*	Games with optimal length SIZE_MAX, i.e. not solved, are skipped. Throws std::runtime_error if writing fails.
+	*/
+	static void write(
+		const std::string& path,
+		const std::size_t& count_target_pieces,
+		const std::size_t& count_non_target_pieces,
+		const std::vector<game>& games,
+		const std::vector<std::size_t>& optimal_lengths
+	) {
+		static constexpr std::size_t UNSOLVED{ std::numeric_limits<std::size_t>::max() };
+
+		std::size_t count_lengths{ 0 };
+		for (const auto& length : optimal_lengths) {
+			if (length != UNSOLVED) count_lengths = std::max(count_lengths, length + 1);
+		}
+
+		// counting sort by optimal length:
+		std::vector<uint64_t> offsets(count_lengths + 1, 0);
+		for (const auto& length : optimal_lengths) {
+			if (length != UNSOLVED) ++offsets[length + 1];
+		}
+		for (std::size_t i{ 0 }; i < count_lengths; ++i) {
+			offsets[i + 1] += offsets[i];
+		}
+
+		std::vector<uint32_t> world_counters(padded_to_8(static_cast<std::size_t>(offsets.back()) * sizeof(uint32_t)) / sizeof(uint32_t), 0);
+		std::vector<uint64_t> state_counters(static_cast<std::size_t>(offsets.back()), 0);
+
+		std::vector<uint64_t> next(offsets.cbegin(), offsets.cend() - 1);
+		for (std::size_t i{ 0 }; i < games.size(); ++i) {
+			if (optimal_lengths[i] == UNSOLVED) continue;
+			const std::size_t position{ static_cast<std::size_t>(next[optimal_lengths[i]]++) };
+			world_counters[position] = static_cast<uint32_t>(games[i].world_generator_counter);
+			state_counters[position] = games[i].state_generator_counter;
+		}
+
+		header h;
+		std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+		h.version = VERSION;
+		h.count_target_pieces = static_cast<uint32_t>(count_target_pieces);
+		h.count_non_target_pieces = static_cast<uint32_t>(count_non_target_pieces);
+		h.count_lengths = static_cast<uint32_t>(count_lengths);
+
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+		out.write(reinterpret_cast<const char*>(offsets.data()), static_cast<std::streamsize>(offsets.size() * sizeof(uint64_t)));
+		out.write(reinterpret_cast<const char*>(world_counters.data()), static_cast<std::streamsize>(world_counters.size() * sizeof(uint32_t)));
+		out.write(reinterpret_cast<const char*>(state_counters.data()), static_cast<std::streamsize>(state_counters.size() * sizeof(uint64_t)));
+		if (!out) {
+			throw std::runtime_error("Cannot write difficulty index file " + path);
+		}
+	}
+
+};
+
+static_assert(sizeof(DifficultyIndex::header) == 24, "DifficultyIndex: header must not contain padding");
+
+/**
+*	@brief Solves games given by generator counters, and builds a DifficultyIndex from them.
+*
+*	@details Board_Generator_T and State_Generator_T must be the generators of the factory which later uses the index.
+*	Games are solved in their canonical rotation, see BoardRotation, and games equal up to rotation are solved only once.
+*/
+template<class Pieces_Quantity_T, class Board_Generator_T, class State_Generator_T>
+class DifficultyIndexer {
+public:
+
+	using pieces_quantity_type = Pieces_Quantity_T;
+
+	using board_generator_type = Board_Generator_T;
+
+	using state_generator_type = State_Generator_T;
+
+	using engine_typeset = ClassicEngineTypeSet<pieces_quantity_type>;
+
+	using positions_of_pieces_type_solver = typename engine_typeset::positions_of_pieces_type_solver;
+
+	using cell_id_type = typename engine_typeset::cell_id_type;
+
+	using distance_exploration_type = tobor::v1_1::distance_exploration<typename engine_typeset::move_engine_type, positions_of_pieces_type_solver>;
+
+	using shared_board_type = SharedBoard<pieces_quantity_type>;
+
+	using board_rotation_type = BoardRotation<pieces_quantity_type>;
+
+	using game = DifficultyIndex::game;
+
+	/**
+	*	@brief A game turned into its canonical rotation. Games equal up to rotation have equal canonical games.
+	*/
+	struct canonical_game {
+		std::shared_ptr<const shared_board_type> board;
+		positions_of_pieces_type_solver initial_state;
+		cell_id_type target_cell;
+
+		inline bool operator<(const canonical_game& another) const noexcept {
+			if (board != another.board) return board < another.board;
+			if (target_cell != another.target_cell) return target_cell < another.target_cell;
+			return initial_state < another.initial_state;
+		}
+
+		inline bool operator==(const canonical_game& another) const noexcept {
+			return board == another.board && target_cell == another.target_cell && initial_state == another.initial_state;
+		}
+	};
+
+	static constexpr std::size_t UNSOLVED{ std::numeric_limits<std::size_t>::max() };
+
+	static_assert(board_generator_type::CYCLIC_GROUP_SIZE <= std::numeric_limits<uint32_t>::max(), "DifficultyIndex stores world generator counters as uint32_t");
+
+	/**
+	*	@brief Returns the canonical rotation of \p g.
+	*/
+	static canonical_game canonical(const game& g) {
+		board_generator_type board_generator;
+		board_generator.set_counter(g.world_generator_counter);
+
+		state_generator_type state_generator;
+		state_generator.set_counter(g.state_generator_counter);
+
+		const auto world{ board_generator.get_tobor_world() };
+		const auto target_cell{ board_generator.get_target_cell() };
+		const auto initial_state{ state_generator.get_positions_of_pieces(world).naked() };
+
+		const uint8_t rotation{ board_rotation_type::canonical_rotation(world, initial_state) };
+
+		return canonical_game{
+			BoardRegistry<pieces_quantity_type>::instance().get(board_rotation_type::turned_world(world, rotation)),
+			board_rotation_type::turned_state(initial_state, world, rotation),
+			board_rotation_type::turned_cell(target_cell, world, rotation)
+		};
+	}
+
+	/**
+	*	@brief Returns the optimal solution length of \p g, or UNSOLVED if it is greater than \p max_depth.
+	*/
+	static std::size_t optimal_length(const canonical_game& g, const std::size_t& max_depth) {
+		distance_exploration_type explorer(g.initial_state);
+
+		const std::size_t length{ explorer.explore_until_target(g.board->move_engine(), g.target_cell, max_depth) };
+
+		return length == distance_exploration_type::SIZE_TYPE_MAX ? UNSOLVED : length;
+	}
+
+	/**
+	*	@brief Returns the optimal solution length of \p g, or UNSOLVED if it is greater than \p max_depth.
+	*/
+	static std::size_t optimal_length(const game& g, const std::size_t& max_depth) {
+		return optimal_length(canonical(g), max_depth);
+	}
+
+	/**
+	*	@brief Returns all games of world generator counters [world_first, world_last) combined with state generator counters [state_first, state_last).
+	*/
+	static std::vector<game> exhaustive_games(uint64_t world_first, uint64_t world_last, uint64_t state_first, uint64_t state_last) {
+		world_last = std::min(world_last, uint64_t(board_generator_type::CYCLIC_GROUP_SIZE));
+		state_last = std::min(state_last, uint64_t(state_generator_type::CYCLIC_GROUP_SIZE));
+
+		std::vector<game> games;
+		if (world_first < world_last && state_first < state_last) {
+			games.reserve(static_cast<std::size_t>((world_last - world_first) * (state_last - state_first)));
+		}
+		for (uint64_t w{ world_first }; w < world_last; ++w) {
+			for (uint64_t s{ state_first }; s < state_last; ++s) {
+				games.push_back(game{ w, s });
+			}
+		}
+		return games;
+	}
+
+	/**
+	*	@brief Returns \p count games, sampled uniformly from all games with a pseudo-random generator seeded by \p seed.
+	*/
+	static std::vector<game> sampled_games(const std::size_t& count, const uint64_t& seed) {
+		std::mt19937_64 generator(seed);
+		std::uniform_int_distribution<uint64_t> world_distribution(0, board_generator_type::CYCLIC_GROUP_SIZE - 1);
+		std::uniform_int_distribution<uint64_t> state_distribution(0, state_generator_type::CYCLIC_GROUP_SIZE - 1);
+
+		std::vector<game> games;
+		games.reserve(count);
+		for (std::size_t i{ 0 }; i < count; ++i) {
+			const uint64_t w{ world_distribution(generator) };
+			games.push_back(game{ w, state_distribution(generator) });
+		}
+		return games;
+	}
+
+	/**
+	*	@brief Solves all \p games in parallel, up to depth \p max_depth, and writes the index to \p path.
+	*
+	*	@return Returns the number of games solved and written to the index.
+	*/
+	static std::size_t build(const std::string& path, std::vector<game> games, const std::size_t& max_depth) {
+		std::sort(games.begin(), games.end(), [](const game& l, const game& r) {
+			return l.world_generator_counter == r.world_generator_counter ?
+				l.state_generator_counter < r.state_generator_counter :
+				l.world_generator_counter < r.world_generator_counter;
+			});
+
+		std::vector<std::optional<canonical_game>> canonical_games(games.size());
+
+		tobor::v1_1::parallel::transform(games.cbegin(), games.cend(), canonical_games.begin(), [](const game& g) {
+			return std::optional<canonical_game>(canonical(g));
+			});
+
+		// solve each class of games equal up to rotation once, neighbouring classes share the board:
+		std::vector<std::size_t> order(games.size());
+		std::iota(order.begin(), order.end(), std::size_t(0));
+		std::sort(order.begin(), order.end(), [&](const std::size_t& l, const std::size_t& r) {
+			return canonical_games[l].value() < canonical_games[r].value();
+			});
+
+		std::vector<std::size_t> representants; // first game of each class in order
+		std::vector<std::size_t> class_of_game(games.size());
+		for (std::size_t i{ 0 }; i < order.size(); ++i) {
+			if (i == 0 || !(canonical_games[order[i - 1]].value() == canonical_games[order[i]].value())) {
+				representants.push_back(order[i]);
+			}
+			class_of_game[order[i]] = representants.size() - 1;
+		}
+
+		std::vector<std::size_t> class_lengths(representants.size());
+
+		tobor::v1_1::parallel::transform(representants.cbegin(), representants.cend(), class_lengths.begin(), [&](const std::size_t& representant) {
+			return optimal_length(canonical_games[representant].value(), max_depth);
+			});
+
+		canonical_games.clear(); // releases the boards
+
+		std::vector<std::size_t> optimal_lengths(games.size());
+		for (std::size_t i{ 0 }; i < games.size(); ++i) {
+			optimal_lengths[i] = class_lengths[class_of_game[i]];
+		}
+
+		DifficultyIndex::write(path, pieces_quantity_type::COUNT_TARGET_PIECES, pieces_quantity_type::COUNT_NON_TARGET_PIECES, games, optimal_lengths);
+
+		return static_cast<std::size_t>(std::count_if(optimal_lengths.cbegin(), optimal_lengths.cend(), [](const std::size_t& l) { return l != UNSOLVED; }));
+	}
+
+};
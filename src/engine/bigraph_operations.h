@@ -3,6 +3,13 @@
 #include "move_engine.h"
 #include "../models/simple_state_digraph.h"
 
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 namespace tobor {
 	namespace v1_1 {
 
@@ -43,7 +50,7 @@ namespace tobor {
 
 				};
 
-				using simulation_links_type = std::map<Source_State_T, std::set<Destination_State_T>>;
+				using simulation_links_type = std::pmr::map<Source_State_T, std::pmr::set<Destination_State_T>>;
 
 				bigraph_simulation_copy() = delete;
 
@@ -66,14 +73,16 @@ namespace tobor {
 						}
 					}
 
-					destination_map_iterator iter_destination_map_initial_state = destination_bigraph.map.insert(
+					destination_map_iterator iter_destination_map_initial_state = destination_bigraph.map.emplace_hint(
 						destination_bigraph.map.begin(),
-						std::make_pair(initial_state_destination, typename destination_bigraph_type::node_links())
+						std::piecewise_construct,
+						std::forward_as_tuple(initial_state_destination),
+						std::forward_as_tuple()
 					);
 
 					//auto iter = source_initial_state_iterator;
 
-					simulation_links_type simulation_links; // should also be part of return value
+					simulation_links_type simulation_links(destination_bigraph.map.get_allocator()); // should also be part of return value
 
 
 					std::vector<simulation_copy_df_record> df_exploration_stack;
@@ -107,9 +116,7 @@ namespace tobor {
 
 
 						//auto& destination_succ_map_value = destination_bigraph.map[similar_successor_state]; // insert successor state, if not present
-						auto [destination_succ_map_iter, inserted_destination_succ] = destination_bigraph.map.insert(
-							std::make_pair(similar_successor_state, typename destination_bigraph_type::node_links())
-						); // insert successor state, if not present
+						auto [destination_succ_map_iter, inserted_destination_succ] = destination_bigraph.map.try_emplace(similar_successor_state); // insert successor state, if not present
 
 						//destination_succ_map_value.predecessors.insert(destination_curr_state); // insert predecessor state, if not present
 						destination_succ_map_iter->second.predecessors.insert(destination_curr_state); // insert predecessor state, if not present
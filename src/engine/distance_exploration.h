@@ -1,7 +1,15 @@
 #pragma once
 
+#include "../models/layered_state.h"
 #include "../models/simple_state_digraph.h"
-
+#include "../trace.h"
+#include "parallel_algorithms.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <span>
+#include <stop_token>
 #include <vector>
 
 namespace tobor {
@@ -26,6 +34,8 @@ namespace tobor {
 
 			using size_type = std::size_t;
 
+			using predecessor_edge_type = typename move_engine_type::template predecessor_edge<positions_of_pieces_type>;
+
 			static constexpr size_type SIZE_TYPE_MAX{ std::numeric_limits<size_type>::max() };
 
 			struct move_candidate {
@@ -79,13 +89,22 @@ namespace tobor {
 
 			using states_vector = std::vector<positions_of_pieces_type>;
 
+			using level_view = std::span<const positions_of_pieces_type>;
+
+			/**
+			*	All explored states, level after level, in one append-only arena.
+			*	New states are appended behind the last level, and only become a level when sorted and filtered.
+			*/
+			states_vector _states;
+
 			/**
 			* conditions:
-			*	- guaranteed to have .size() > 0
-			*	- the first entry _reachable_states_by_distance[0] has always length 1 and contains the initial state
-			*	- the vector at index i contains exactly the states which are reachable by an optimal path of length i
+			*	- guaranteed to have .size() > 1, _level_offsets.front() == 0 and _level_offsets.back() <= _states.size()
+			*	- level i consists of the states from _states[_level_offsets[i]] until before _states[_level_offsets[i + 1]], sorted
+			*	- level 0 has always length 1 and contains the initial state
+			*	- level i contains exactly the states which are reachable by an optimal path of length i
 			*/
-			std::vector<states_vector> _reachable_states_by_distance;
+			std::vector<size_type> _level_offsets;
 
 			/**
 			* maps target cells to their minimal distance from initial state
@@ -98,42 +117,67 @@ namespace tobor {
 			bool _entirely_explored{ false };
 
 			/**
-			*	@brief Sorts states inside _reachable_states_by_distance[index], removes duplicates
+			*	Exploration returns early once a stop is requested, checked every STOP_CHECK_INTERVAL expanded states.
+			*/
+			std::stop_token _stop_token;
+
+			static constexpr size_type STOP_CHECK_INTERVAL{ 4096 };
+
+			/**
+			*	@brief Returns the number of explored levels, i.e. exploration_depth() + 1.
+			*/
+			inline size_type count_levels() const noexcept { return _level_offsets.size() - 1; }
+
+			/**
+			*	@brief Returns the states of level \p index. Invalidated when exploring further.
 			*/
-			inline void sort_unique(const typename std::vector<states_vector>::size_type& index /* new states index */) {
+			inline level_view level(const size_type& index) const {
+				return level_view(_states.data() + _level_offsets[index], _level_offsets[index + 1] - _level_offsets[index]);
+			}
+
+			/**
+			*	@brief Sorts the new states behind the last level, removes duplicates
+			*/
+			inline void sort_unique() {
+				TOBOR_TRACE_SCOPE("distance_exploration::sort_unique");
 				static constexpr bool USE_RADIX_SORT{ true };
 
+				const auto first{ _states.begin() + _level_offsets.back() };
+
 				if constexpr (USE_RADIX_SORT) {
-					positions_of_pieces_type::collection_sort_unique(_reachable_states_by_distance[index]);
+					_states.erase(positions_of_pieces_type::range_sort_unique(first, _states.end()), _states.end());
 				}
 				else {
-					std::sort(/*std::execution::par,*/ _reachable_states_by_distance[index].begin(), _reachable_states_by_distance[index].end());
+					std::sort(/*std::execution::par,*/ first, _states.end());
 
-					_reachable_states_by_distance[index].erase(
-						unique(/*std::execution::par,*/ _reachable_states_by_distance[index].begin(), _reachable_states_by_distance[index].end()),
-						_reachable_states_by_distance[index].end()
+					_states.erase(
+						unique(/*std::execution::par,*/ first, _states.end()),
+						_states.end()
 					);
 				}
 			}
 
 			/**
-			*	@brief Removes states inside _reachable_states_by_distance[index] which have already been seen within some shorter distance
+			*	@brief Removes the new states behind the last level which have already been seen within some shorter distance
 			*/
-			inline void erase_seen_before(const typename std::vector<states_vector>::size_type& index /* new states index */) {
+			inline void erase_seen_before() {
+				TOBOR_TRACE_SCOPE("distance_exploration::erase_seen_before");
 
-				using sub_iterator = typename std::vector<positions_of_pieces_type>::iterator;
+				using sub_iterator = typename states_vector::iterator;
 				std::vector<sub_iterator> check_iterators;
-				sub_iterator check_next = _reachable_states_by_distance[index].begin();
-				sub_iterator free_next = _reachable_states_by_distance[index].begin();
+				std::vector<sub_iterator> check_ends;
+				sub_iterator check_next = _states.begin() + _level_offsets.back();
+				sub_iterator free_next = check_next;
 
-				for (size_type i = 0; i < index; ++i) {
-					check_iterators.emplace_back(_reachable_states_by_distance[i].begin());
+				for (size_type i = 0; i < count_levels(); ++i) {
+					check_iterators.emplace_back(_states.begin() + _level_offsets[i]);
+					check_ends.emplace_back(_states.begin() + _level_offsets[i + 1]);
 				}
 			continue_outer_loop:
-				while (check_next != _reachable_states_by_distance[index].end()) {
+				while (check_next != _states.end()) {
 					for (size_type i_level = 0; i_level < check_iterators.size(); ++i_level) {
 						while (
-							(check_iterators[i_level] != _reachable_states_by_distance[i_level].end())
+							(check_iterators[i_level] != check_ends[i_level])
 							&&
 							(*(check_iterators[i_level]) < *check_next)
 							)
@@ -141,7 +185,7 @@ namespace tobor {
 							++check_iterators[i_level];
 						}
 						if (
-							(check_iterators[i_level] != _reachable_states_by_distance[i_level].end())
+							(check_iterators[i_level] != check_ends[i_level])
 							&&
 							*check_iterators[i_level] == *check_next
 							)
@@ -158,8 +202,41 @@ namespace tobor {
 					++free_next;
 					++check_next;
 				}
-				// shrink the vector by the elements already found earlier.
-				_reachable_states_by_distance[index].erase(free_next, _reachable_states_by_distance[index].end());
+				// shrink the arena by the elements already found earlier.
+				_states.erase(free_next, _states.end());
+			}
+
+			/**
+			*	@brief Turns the new states behind the last level into the next level.
+			*
+			*	@details Sorting and filtering work in place on the tail of the arena.
+			*/
+			inline void close_level() {
+				sort_unique();
+				erase_seen_before();
+				_level_offsets.push_back(_states.size());
+			}
+
+			/**
+			*	@brief Releases the arena capacity left from the unfiltered successor states of the last expanded level, if it exceeds the size of the arena.
+			*
+			*	@details Called once after exploring, so that explored levels are not copied on each expansion.
+			*/
+			inline void shrink_arena() {
+				if (_states.capacity() > 2 * _states.size()) {
+					_states.shrink_to_fit();
+				}
+			}
+
+			/**
+			*	@brief Returns true if and only if a stop has been requested. Then drops the new states behind the last level, so that only completely explored levels remain.
+			*/
+			inline bool drop_new_states_if_stopped() {
+				if (!_stop_token.stop_requested()) {
+					return false;
+				}
+				_states.erase(_states.begin() + _level_offsets.back(), _states.end());
+				return true;
 			}
 
 			/**
@@ -272,7 +349,9 @@ namespace tobor {
 				const exploration_policy& policy,
 				const bool NOT_YET_FOUND_GUARANTEED = false
 			) {
-				const size_type INDEX_LAST_EXPLORATION{ _reachable_states_by_distance.size() - 1 };
+				TOBOR_TRACE_SCOPE("distance_exploration::explore_until_target");
+
+				const size_type INDEX_LAST_EXPLORATION{ count_levels() - 1 };
 
 				size_type optimal_depth{ SIZE_TYPE_MAX }; // guaranteed not yet found if NOT_YET_FOUND_GUARANTEED == true
 
@@ -284,32 +363,41 @@ namespace tobor {
 					&& states_counter < policy.state_count_threshold() /* policy abort*/;
 					++expand_level_index) {
 
-					if (_reachable_states_by_distance[expand_level_index].size() == 0) {
+					if (level(expand_level_index).empty()) {
 						_entirely_explored = true;
-						return SIZE_TYPE_MAX; // no more states to find
+						break; // no more states to find
 					}
 
-					_reachable_states_by_distance.emplace_back();
-					_reachable_states_by_distance[expand_level_index + 1].reserve(_reachable_states_by_distance[expand_level_index].size() * 3 + 10);
+					TOBOR_TRACE_SCOPE("distance_exploration::expand_level");
+
+					for (size_type expand_index{ _level_offsets[expand_level_index] }; expand_index < _level_offsets[expand_level_index + 1]; ++expand_index) {
+						if (expand_index % STOP_CHECK_INTERVAL == 0 && _stop_token.stop_requested()) {
+							break;
+						}
 
-					for (std::size_t expand_index_inside_level = 0; expand_index_inside_level < _reachable_states_by_distance[expand_level_index].size(); ++expand_index_inside_level) {
+						const positions_of_pieces_type current_state{ _states[expand_index] }; // copy, appending may reallocate the arena
 
 						if (
-							add_all_nontrivial_successor_states(engine, _reachable_states_by_distance[expand_level_index][expand_index_inside_level], target_cell, std::back_inserter(_reachable_states_by_distance.back()))
+							add_all_nontrivial_successor_states(engine, current_state, target_cell, std::back_inserter(_states))
 							)
 						{
 							optimal_depth = expand_level_index + 1;
 						}
 					}
 
-					sort_unique(expand_level_index + 1);
-					erase_seen_before(expand_level_index + 1);
-					_reachable_states_by_distance[expand_level_index + 1].shrink_to_fit();
+					if (drop_new_states_if_stopped()) {
+						optimal_depth = SIZE_TYPE_MAX; // the level containing a final state is incomplete
+						break;
+					}
 
-					states_counter += _reachable_states_by_distance[expand_level_index + 1].size();
+					close_level();
+
+					states_counter += level(expand_level_index + 1).size();
+					TOBOR_TRACE_COUNTER("distance_exploration::states", states_counter);
 				}
 
 				// finalizing:
+				shrink_arena();
 				if (NOT_YET_FOUND_GUARANTEED)
 					if (optimal_depth != SIZE_TYPE_MAX) {
 						_optimal_path_length_map.insert(std::make_pair(target_cell, optimal_depth));
@@ -317,37 +405,155 @@ namespace tobor {
 				return optimal_depth;
 			}
 
+			/**
+			*	@brief Replaces \p possible_edges by all edges from predecessor states of \p states. Edges are generated in parallel, chunk by chunk of \p states.
+			*/
+			inline static void collect_predecessor_edges(
+				const move_engine_type& engine,
+				const level_view& states,
+				std::vector<predecessor_edge_type>& possible_edges
+			) {
+				TOBOR_TRACE_SCOPE("distance_exploration::collect_predecessor_edges");
+
+				static constexpr size_type CHUNK_SIZE{ 256 };
+
+				const size_type COUNT_CHUNKS{ (states.size() + CHUNK_SIZE - 1) / CHUNK_SIZE };
+
+				std::vector<std::vector<predecessor_edge_type>> chunk_edges(COUNT_CHUNKS);
+
+				std::vector<size_type> chunk_indices(COUNT_CHUNKS);
+				std::iota(chunk_indices.begin(), chunk_indices.end(), size_type(0));
+
+				parallel::for_each(chunk_indices.cbegin(), chunk_indices.cend(), [&](const size_type& chunk) {
+					const auto first{ states.begin() + chunk * CHUNK_SIZE };
+					const auto last{ states.begin() + std::min((chunk + 1) * CHUNK_SIZE, states.size()) };
+					engine.template add_predecessor_edges<positions_of_pieces_type>(first, last, std::back_inserter(chunk_edges[chunk]));
+					});
+
+				possible_edges.clear();
+				possible_edges.reserve(
+					std::accumulate(chunk_edges.cbegin(), chunk_edges.cend(), size_type(0), [](const size_type& acc, const auto& el) { return acc + el.size(); })
+				);
+				for (auto& edges : chunk_edges) {
+					std::move(edges.begin(), edges.end(), std::back_inserter(possible_edges));
+				}
+			}
+
+			/**
+			*	@brief Removes all edges from \p possible_edges whose predecessor is not contained in \p states.
+			*
+			*	@details Merge-join, requires both \p possible_edges and \p states to be sorted by predecessor state.
+			*/
+			inline static void keep_edges_from_level(std::vector<predecessor_edge_type>& possible_edges, const level_view& states) {
+				auto free_next = possible_edges.begin();
+				auto level_iter = states.begin();
+
+				for (auto edge_iter = possible_edges.begin(); edge_iter != possible_edges.end(); ++edge_iter) {
+					while (level_iter != states.end() && *level_iter < edge_iter->predecessor) {
+						++level_iter;
+					}
+					if (level_iter == states.end()) {
+						break; // all remaining edges have predecessors beyond level
+					}
+					if (*level_iter == edge_iter->predecessor) {
+						if (free_next != edge_iter) {
+							*free_next = std::move(*edge_iter);
+						}
+						++free_next;
+					}
+				}
+				possible_edges.erase(free_next, possible_edges.end());
+			}
+
+			/**
+			*	@brief Inserts one node for each state of \p nodes into \p destination, linked by \p edges.
+			*
+			*	@details \p nodes must be sorted and unique and must contain all states occurring in \p edges.
+			*	\p edges must be sorted by (predecessor, successor). As everything is inserted in order, all map and set insertions are hinted at the end.
+			*/
+			template<class State_Label_T>
+			inline static void build_bigraph(
+				const states_vector& nodes,
+				const std::vector<predecessor_edge_type>& edges,
+				simple_state_digraph<positions_of_pieces_type, State_Label_T>& destination
+			) {
+				TOBOR_TRACE_SCOPE("distance_exploration::build_bigraph");
+
+				using bigraph = simple_state_digraph<positions_of_pieces_type, State_Label_T>;
+
+				std::vector<const predecessor_edge_type*> edges_by_successor(edges.size());
+				std::transform(edges.cbegin(), edges.cend(), edges_by_successor.begin(), [](const predecessor_edge_type& edge) { return &edge; });
+				parallel::sort(edges_by_successor.begin(), edges_by_successor.end(), [](const predecessor_edge_type* l, const predecessor_edge_type* r) {
+					return l->successor == r->successor ? l->predecessor < r->predecessor : l->successor < r->successor;
+					});
+
+				auto out_iter = edges.cbegin();
+				auto in_iter = edges_by_successor.cbegin();
+
+				for (const auto& node : nodes) {
+					typename bigraph::node_links links(destination.map.get_allocator());
+					for (; out_iter != edges.cend() && out_iter->predecessor == node; ++out_iter) {
+						links.successors.insert(links.successors.end(), out_iter->successor);
+					}
+					for (; in_iter != edges_by_successor.cend() && (*in_iter)->successor == node; ++in_iter) {
+						links.predecessors.insert(links.predecessors.end(), (*in_iter)->predecessor);
+					}
+					destination.map.emplace_hint(destination.map.end(), node, std::move(links));
+				}
+			}
+
+			/**
+			*	@brief Returns true if and only if \p state has been explored at some depth not greater than \p depth.
+			*/
+			inline bool explored_within(const positions_of_pieces_type& state, const size_type& depth) const {
+				for (size_type d{ 0 }; d <= depth && d < count_levels(); ++d) {
+					if (std::binary_search(level(d).begin(), level(d).end(), state)) {
+						return true;
+					}
+				}
+				return false;
+			}
+
 		public:
 			/**
 			*	@brief Constructs an object with empty exploration state space.
 			*/
 			distance_exploration(const positions_of_pieces_type& initial_state) :
+				_states{ initial_state },
+				_level_offsets{ 0, 1 },
 				_optimal_path_length_map(),
 				_entirely_explored(false)
 			{
-				_reachable_states_by_distance.emplace_back(std::vector<positions_of_pieces_type>{ initial_state });
 			}
 
 			/**
 			*	@brief Returns the total number of states reached from initial state during exploration, including the initial state itself.
 			*/
 			inline size_type count_states() const noexcept {
-				return std::accumulate(
-					std::begin(_reachable_states_by_distance),
-					std::end(_reachable_states_by_distance),
-					size_type(0),
-					[](const size_type& acc, const auto& el) { return acc + el.size(); });
+				return _level_offsets.back();
 			}
 
+			/**
+			*	@brief Returns the initial state the exploration started from.
+			*/
+			inline const positions_of_pieces_type& initial_state() const noexcept { return _states.front(); }
+
 			/**
 			*	@brief Returns true if and only if the entire state space has been explored.
 			*/
 			inline bool entirely_explored() const noexcept { return _entirely_explored; }
 
+			/**
+			*	@brief Makes exploration return early, without completing the current level, once a stop is requested on \p stop_token. Pass a default constructed token to remove it.
+			*
+			*	@details An exploration stopped that way finds no optimal path length. The levels explored before stay valid, so exploration can continue later.
+			*/
+			inline void set_stop_token(std::stop_token stop_token) noexcept { _stop_token = std::move(stop_token); }
+
 			/**
 			*	@brief Returns the may depth of previously executed exploration.
 			*/
-			inline size_type exploration_depth() const noexcept { return _reachable_states_by_distance.size() - 1; }
+			inline size_type exploration_depth() const noexcept { return count_levels() - 1; }
 
 			/**
 			*	@brief Explores according to \p policy (until entirely explored or until running into some policy threshold)
@@ -356,7 +562,9 @@ namespace tobor {
 				const move_engine_type& engine,
 				const exploration_policy& policy
 			) {
-				const size_type INDEX_LAST_EXPLORATION{ _reachable_states_by_distance.size() - 1 };
+				TOBOR_TRACE_SCOPE("distance_exploration::explore");
+
+				const size_type INDEX_LAST_EXPLORATION{ count_levels() - 1 };
 
 				size_type states_counter{ count_states() };
 
@@ -366,24 +574,33 @@ namespace tobor {
 					++expand_level_index
 					)
 				{
-					if (_reachable_states_by_distance[expand_level_index].size() == 0) {
+					if (level(expand_level_index).empty()) {
 						_entirely_explored = true;
-						return; // no more states to find
+						break; // no more states to find
 					}
 
-					_reachable_states_by_distance.emplace_back();
-					_reachable_states_by_distance[expand_level_index + 1].reserve(_reachable_states_by_distance[expand_level_index].size() * 3 + 10);
+					TOBOR_TRACE_SCOPE("distance_exploration::expand_level");
+
+					for (size_type expand_index{ _level_offsets[expand_level_index] }; expand_index < _level_offsets[expand_level_index + 1]; ++expand_index) {
+						if (expand_index % STOP_CHECK_INTERVAL == 0 && _stop_token.stop_requested()) {
+							break;
+						}
+
+						const positions_of_pieces_type current_state{ _states[expand_index] }; // copy, appending may reallocate the arena
+						add_all_nontrivial_successor_states(engine, current_state, std::back_inserter(_states));
+					}
 
-					for (std::size_t expand_index_inside_level = 0; expand_index_inside_level < _reachable_states_by_distance[expand_level_index].size(); ++expand_index_inside_level) {
-						add_all_nontrivial_successor_states(engine, _reachable_states_by_distance[expand_level_index][expand_index_inside_level], std::back_inserter(_reachable_states_by_distance.back()));
+					if (drop_new_states_if_stopped()) {
+						break;
 					}
 
-					sort_unique(expand_level_index + 1);
-					erase_seen_before(expand_level_index + 1);
-					_reachable_states_by_distance[expand_level_index + 1].shrink_to_fit();
+					close_level();
 
-					states_counter += _reachable_states_by_distance[expand_level_index + 1].size();
+					states_counter += level(expand_level_index + 1).size();
+					TOBOR_TRACE_COUNTER("distance_exploration::states", states_counter);
 				}
+
+				shrink_arena();
 			}
 
 			/**
@@ -417,8 +634,8 @@ namespace tobor {
 				}
 
 				// checking explored states...
-				for (size_type depth{ min_length_hint }; depth < _reachable_states_by_distance.size(); ++depth) {
-					for (const auto& state : _reachable_states_by_distance[depth]) {
+				for (size_type depth{ min_length_hint }; depth < count_levels(); ++depth) {
+					for (const auto& state : level(depth)) {
 						if (state.is_final(target_cell)) {
 							if (min_length_hint == 0) { // only update cache if there was no hint
 								_optimal_path_length_map.insert(std::make_pair(target_cell, depth));
@@ -435,6 +652,75 @@ namespace tobor {
 				return explore_until_target(engine, target_cell, policy, min_length_hint == 0);
 			}
 
+			/**
+			*	@brief Determines the optimal path lengths for all \p target_cells at once, exploring further if allowed by \p policy until all of them are reached.
+			*
+			*	@details Each level is scanned only once for all targets not yet reached. Found lengths are added to the per-target cache.
+			*	@return Returns the map from target cell to optimal path length, containing only the target cells reached.
+			*/
+			inline target_distance_map_type optimal_path_lengths(const move_engine_type& engine, const std::vector<cell_id_type>& target_cells, const exploration_policy& policy = exploration_policy::FORCE_EXPLORATION_UNRESTRICTED()) {
+				target_distance_map_type result;
+
+				std::vector<cell_id_type> pending; // sorted, not in cache
+				for (const auto& target_cell : target_cells) {
+					const auto iter = _optimal_path_length_map.find(target_cell);
+					if (iter != _optimal_path_length_map.cend()) {
+						result.insert(*iter);
+					}
+					else {
+						pending.push_back(target_cell);
+					}
+				}
+				std::sort(pending.begin(), pending.end());
+				pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+
+				if (policy == exploration_policy::ONLY_CASHED()) {
+					return result;
+				}
+
+				std::vector<cell_id_type> found;
+
+				for (size_type depth{ 0 }; !pending.empty(); ++depth) {
+					if (!(depth < count_levels())) {
+						if (
+							policy == exploration_policy::ONLY_EXPLORED()
+							|| _entirely_explored
+							|| !(depth <= policy.max_depth())
+							|| !(count_states() < policy.state_count_threshold())
+							) {
+							break;
+						}
+						explore(engine, exploration_policy::FORCE_EXPLORATION_STATE_THRESHOLD_UNTIL_DEPTH(policy.state_count_threshold(), depth));
+						if (!(depth < count_levels())) {
+							break; // entirely explored
+						}
+					}
+
+					// scan level for all pending targets:
+					found.clear();
+					for (const auto& state : level(depth)) {
+						for (auto iter = state.target_pieces_cbegin(); iter != state.target_pieces_cend(); ++iter) {
+							if (std::binary_search(pending.cbegin(), pending.cend(), *iter)) {
+								found.push_back(*iter);
+							}
+						}
+					}
+					std::sort(found.begin(), found.end());
+					found.erase(std::unique(found.begin(), found.end()), found.end());
+
+					for (const auto& target_cell : found) {
+						result.insert(std::make_pair(target_cell, depth));
+						_optimal_path_length_map.insert(std::make_pair(target_cell, depth));
+					}
+					pending.erase(
+						std::remove_if(pending.begin(), pending.end(), [&](const cell_id_type& c) { return std::binary_search(found.cbegin(), found.cend(), c); }),
+						pending.end()
+					);
+				}
+
+				return result;
+			}
+
 			/**
 			*	@brief Explores until reaching \p target_cell, if allowed by \p policy. The policy determines if it performs additional exploration or if it only looks up in previously cached or explored solutions.
 			*
@@ -444,18 +730,62 @@ namespace tobor {
 				std::vector<positions_of_pieces_type> result;
 				const size_type DEPTH{ optimal_path_length(engine, target_cell, policy, min_length_hint) };
 
-				if (!(DEPTH < _reachable_states_by_distance.size()))
+				if (!(DEPTH < count_levels()))
 					return result;
 
-				for (auto state_iter = _reachable_states_by_distance[DEPTH].cbegin(); state_iter != _reachable_states_by_distance[DEPTH].cend(); ++state_iter) {
-					if (*state_iter.is_final(target_cell)) {
-						result.push_back(*state_iter);
+				for (const auto& state : level(DEPTH)) {
+					if (state.is_final(target_cell)) {
+						result.push_back(state);
 					}
 				}
 
 				return result;
 			}
 
+			/**
+			*	@brief Extracts one optimal path for reaching \p target_cell, without building the graph of all optimal solutions.
+			*
+			*	@details Explores the state space according to \p policy. Walks back from the first final state, level by level, choosing the first predecessor contained in the next lower level.
+			*	@return Returns the states from initial state to a final state, or an empty vector if no optimal path was found, perhaps due to \p policy.
+			*/
+			std::vector<positions_of_pieces_type> optimal_state_path(
+				const move_engine_type& engine,
+				const cell_id_type& target_cell,
+				const exploration_policy& policy = exploration_policy::ONLY_EXPLORED()
+			) {
+				TOBOR_TRACE_SCOPE("distance_exploration::optimal_state_path");
+
+				std::vector<positions_of_pieces_type> path;
+
+				const size_type FINAL_DEPTH{ optimal_path_length(engine, target_cell, policy) };
+
+				if (!(FINAL_DEPTH < count_levels()))
+					return path;
+
+				const auto final_state{ std::find_if(
+					level(FINAL_DEPTH).begin(),
+					level(FINAL_DEPTH).end(),
+					[&](const positions_of_pieces_type& s) { return s.is_final(target_cell); }
+				) };
+
+				path.resize(FINAL_DEPTH + 1, *final_state);
+
+				std::vector<positions_of_pieces_type> predecessors; // reused on each level
+				predecessors.reserve(engine.max_count_predecessor_states());
+
+				for (size_type depth{ FINAL_DEPTH }; depth > 0; --depth) {
+					const level_view lower_level{ level(depth - 1) };
+
+					predecessors.clear();
+					engine.template add_predecessor_states<positions_of_pieces_type>(path[depth], std::back_inserter(predecessors));
+
+					// each state at depth has a predecessor at depth - 1:
+					path[depth - 1] = *std::find_if(predecessors.cbegin(), predecessors.cend(), [&](const positions_of_pieces_type& s) { return std::binary_search(lower_level.begin(), lower_level.end(), s); });
+				}
+
+				return path;
+			}
+
 			/**
 			*	@brief Extracts the simple_state_digraph containing all optimal solutions for reaching \p target_cell.
 			*
@@ -469,81 +799,158 @@ namespace tobor {
 				const exploration_policy& policy = exploration_policy::ONLY_EXPLORED(),
 				const size_type& min_length_hint = 0
 			) {
-				using bigraph = simple_state_digraph<positions_of_pieces_type, State_Label_T>;
+				TOBOR_TRACE_SCOPE("distance_exploration::get_simple_bigraph");
 
 				destination.clear();
 
 				const size_type FINAL_DEPTH{ optimal_path_length(engine, target_cell, policy, min_length_hint) };
 
-				if (!(FINAL_DEPTH < _reachable_states_by_distance.size()))
+				if (!(FINAL_DEPTH < count_levels()))
 					return;
 
 				std::vector<positions_of_pieces_type> states;
 
 				// fill states with all the final states
-				for (size_type i{ 0 }; i < _reachable_states_by_distance[FINAL_DEPTH].size(); ++i) {
-					const auto& s{ _reachable_states_by_distance[FINAL_DEPTH][i] };
-					if (s.is_final(target_cell)) {
-						destination.map.insert(
-							destination.map.end(),
-							std::pair<typename bigraph::state_type, typename bigraph::node_links>(
-								_reachable_states_by_distance[FINAL_DEPTH][i],
-								typename bigraph::node_links()
-							)
-						);
-						states.push_back(s);
-					}
-				}
+				std::copy_if(
+					level(FINAL_DEPTH).begin(),
+					level(FINAL_DEPTH).end(),
+					std::back_inserter(states),
+					[&](const positions_of_pieces_type& s) { return s.is_final(target_cell); }
+				);
+
+				// all states of the bigraph, collected first, inserted in bulk when done
+				std::vector<positions_of_pieces_type> nodes(states);
+
+				std::vector<predecessor_edge_type> all_edges;
+
+				std::vector<predecessor_edge_type> possible_edges; // reused on each level
 
 				std::size_t backward_explore_distance = FINAL_DEPTH;
 
 				while (backward_explore_distance > 0) {
-					--backward_explore_distance;
+					TOBOR_TRACE_SCOPE("distance_exploration::backward_level");
 
-					std::vector<std::pair<positions_of_pieces_type, positions_of_pieces_type>> possible_edges;
+					--backward_explore_distance;
 
 					// all maybe-edges
-					for (const auto& state : states) {
-						auto vec = engine.predecessor_states(state);
-						//possible_edges.reserve(possible_edges.size() + vec.size());
-						for (const positions_of_pieces_type& pred_state : vec) {
-							possible_edges.emplace_back(pred_state, state);
+					collect_predecessor_edges(engine, states, possible_edges);
+
+					// sort by from-state
+					parallel::sort(possible_edges.begin(), possible_edges.end());
+
+					// remove if from state not in distance state vector
+					keep_edges_from_level(possible_edges, level(backward_explore_distance));
+
+					// pass vector of pre-states to next loop run:
+					states.clear();
+
+					for (const predecessor_edge_type& edge : possible_edges) {
+						if (states.empty() || states.back() != edge.predecessor) {
+							states.push_back(edge.predecessor);
 						}
 					}
-					// sort by from-state
-					std::sort(possible_edges.begin(), possible_edges.end());
 
-					//remove if from state not in distance state vector
-					std::size_t compare_index{ 0 };
+					std::copy(states.cbegin(), states.cend(), std::back_inserter(nodes));
+					std::move(possible_edges.begin(), possible_edges.end(), std::back_inserter(all_edges));
+				}
 
-					possible_edges.erase(
-						std::remove_if(possible_edges.begin(), possible_edges.end(), [&](const std::pair<positions_of_pieces_type, positions_of_pieces_type>& edge) {
-							while (compare_index < _reachable_states_by_distance[backward_explore_distance].size() && _reachable_states_by_distance[backward_explore_distance][compare_index] < edge.first) {
-								++compare_index;
-							}
-							if (compare_index < _reachable_states_by_distance[backward_explore_distance].size() && _reachable_states_by_distance[backward_explore_distance][compare_index] == edge.first) {
-								return false; // do not remove edge
-							}
-							return true; // remove edge
-							}),
-						possible_edges.end()
+				// levels are disjoint, each level sorted, but all levels together are not:
+				parallel::sort(nodes.begin(), nodes.end());
+				parallel::sort(all_edges.begin(), all_edges.end());
+
+				build_bigraph(nodes, all_edges, destination);
+			}
+
+			/**
+			*	@brief Extracts the layered simple_state_digraph of all paths of length optimal + \p slack reaching \p target_cell, each state labelled by its index on the path.
+			*
+			*	@details Determines the optimal path length according to \p policy and explores \p slack levels beyond.
+			*	Final states only occur at the end of the paths, since any other path just extends a shorter solution. A state at path index i must have been explored within depth i.
+			*	Layers are collected backwards from the final states like in get_simple_bigraph(), then all states not reachable from the initial state are removed.
+			*	Note that paths of the graph may still revisit states if \p slack > 1.
+			*	@return Returns false if and only if no optimal path was found, perhaps due to \p policy. Then \p destination is empty.
+			*/
+			template<class State_Label_T>
+			bool get_near_optimal_bigraph(
+				const move_engine_type& engine,
+				const cell_id_type& target_cell,
+				const size_type& slack,
+				simple_state_digraph<layered_state<positions_of_pieces_type>, State_Label_T>& destination,
+				const exploration_policy& policy = exploration_policy::ONLY_EXPLORED()
+			) {
+				TOBOR_TRACE_SCOPE("distance_exploration::get_near_optimal_bigraph");
+
+				using node_type = layered_state<positions_of_pieces_type>;
+
+				destination.clear();
+
+				const size_type OPTIMAL_DEPTH{ optimal_path_length(engine, target_cell, policy) };
+
+				if (!(OPTIMAL_DEPTH < count_levels()))
+					return false;
+
+				const size_type PATH_LENGTH{ OPTIMAL_DEPTH + slack };
+
+				explore(engine, exploration_policy::FORCE_EXPLORATION_UNTIL_DEPTH(PATH_LENGTH));
+
+				std::vector<states_vector> layers(PATH_LENGTH + 1);
+
+				std::vector<std::vector<predecessor_edge_type>> layer_edges(PATH_LENGTH); // layer_edges[i] leads from layers[i] to layers[i + 1]
+
+				for (size_type depth{ OPTIMAL_DEPTH }; depth <= PATH_LENGTH && depth < count_levels(); ++depth) {
+					std::copy_if(
+						level(depth).begin(),
+						level(depth).end(),
+						std::back_inserter(layers.back()),
+						[&](const positions_of_pieces_type& s) { return s.is_final(target_cell); }
 					);
+				}
+				std::sort(layers.back().begin(), layers.back().end());
 
-					// add edges to the bigraph:
-					states.clear();
+				// backwards from the final states:
+				for (size_type layer{ PATH_LENGTH }; layer > 0; --layer) {
+					auto& edges{ layer_edges[layer - 1] };
 
-					for (const std::pair<positions_of_pieces_type, positions_of_pieces_type>& edge : possible_edges) {
-						if (states.empty() || states.back() != edge.first) {
-							states.push_back(edge.first);
+					collect_predecessor_edges(engine, layers[layer], edges);
+
+					edges.erase(
+						std::remove_if(edges.begin(), edges.end(), [&](const predecessor_edge_type& edge) {
+							return edge.predecessor.is_final(target_cell) || !explored_within(edge.predecessor, layer - 1);
+							}),
+						edges.end()
+					);
+					parallel::sort(edges.begin(), edges.end());
+
+					for (const predecessor_edge_type& edge : edges) {
+						if (layers[layer - 1].empty() || layers[layer - 1].back() != edge.predecessor) {
+							layers[layer - 1].push_back(edge.predecessor);
 						}
-						auto& s{ destination.map[edge.first].successors };
-						s.insert(s.end(), edge.second);
-						auto& p{ destination.map[edge.second].predecessors };
-						p.insert(p.end(), edge.first);
 					}
+				}
+
+				// forwards from the initial state, the only state explored within depth 0:
+				for (size_type layer{ 0 }; layer < PATH_LENGTH; ++layer) {
+					keep_edges_from_level(layer_edges[layer], layers[layer]);
+
+					layers[layer + 1].clear();
+					for (const predecessor_edge_type& edge : layer_edges[layer]) {
+						layers[layer + 1].push_back(edge.successor);
+					}
+					std::sort(layers[layer + 1].begin(), layers[layer + 1].end());
+					layers[layer + 1].erase(std::unique(layers[layer + 1].begin(), layers[layer + 1].end()), layers[layer + 1].end());
+				}
 
-					// pass vector of pre-states to next loop run.
+				for (size_type layer{ 0 }; layer < PATH_LENGTH; ++layer) {
+					for (const predecessor_edge_type& edge : layer_edges[layer]) {
+						destination.map[node_type(layer, edge.predecessor)].successors.insert(node_type(layer + 1, edge.successor));
+						destination.map[node_type(layer + 1, edge.successor)].predecessors.insert(node_type(layer, edge.predecessor));
+					}
+				}
+				if (PATH_LENGTH == 0) {
+					destination.map[node_type(0, initial_state())];
 				}
+
+				return true;
 			}
 		};
 
@@ -1,7 +1,11 @@
 #pragma once
 
 #include "../models/direction.h"
+#include "../trace.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
 #include <vector>
 
 namespace tobor {
@@ -37,10 +41,62 @@ namespace tobor {
 				};
 			};
 
+			/**
+			*	@brief An edge of the state graph: moving \p predecessor by \p move results in \p successor.
+			*/
+			template<class Position_Of_Pieces_T>
+			struct predecessor_edge {
+				Position_Of_Pieces_T predecessor;
+				Position_Of_Pieces_T successor;
+				piece_move_type move;
+
+				predecessor_edge(const Position_Of_Pieces_T& predecessor, const Position_Of_Pieces_T& successor, const piece_move_type& move) :
+					predecessor(predecessor), successor(successor), move(move) {}
+
+				/** Lexicographic order by (predecessor, successor). */
+				inline bool operator<(const predecessor_edge& another) const {
+					return predecessor == another.predecessor ? successor < another.successor : predecessor < another.predecessor;
+				}
+			};
+
 		private:
 
 			quick_move_cache_type _cache;
 
+			/**
+			*	@brief Calls \p visitor(predecessor, moved_piece_cell) for all predecessor states of \p state when the piece \p _piece_id was moved from \p _direction_from.
+			*
+			*	@details moved_piece_cell is the cell where the moved piece is located in the predecessor state.
+			*/
+			template<class Position_Of_Pieces_T, class Visitor_T>
+			inline void visit_predecessor_states(
+				const Position_Of_Pieces_T& state,
+				const typename piece_move_type::piece_id_type& _piece_id,
+				const direction& _direction_from,
+				Visitor_T&& visitor
+			) const {
+				const cell_id_type start_cell{ state.piece_positions()[_piece_id.value] };
+
+				const cell_id_int_type raw_start_cell_id{ start_cell.get_raw_id(_direction_from, board()) };
+
+				// need to check if we can stop here coming from _direction_from.
+				// return if there is no obstacle in opposite direction
+				if (next_cell_max_move_raw(raw_start_cell_id, state, !_direction_from) != raw_start_cell_id)
+					return;
+
+				const cell_id_int_type raw_far_id{ next_cell_max_move_raw(raw_start_cell_id, state, _direction_from) };
+
+				const int8_t increment{ static_cast<int8_t>((raw_start_cell_id > raw_far_id) - (raw_start_cell_id < raw_far_id)) };
+
+				for (cell_id_int_type raw_id = raw_far_id; raw_id != raw_start_cell_id; raw_id += increment) {
+					const cell_id_type moved_piece_cell{ cell_id_type::create_by_raw_id(_direction_from, raw_id, board()) };
+					Position_Of_Pieces_T predecessor(state);
+					predecessor.piece_positions()[_piece_id.value] = moved_piece_cell;
+					predecessor.sort_pieces();
+					visitor(std::move(predecessor), moved_piece_cell);
+				}
+			}
+
 		public:
 
 			/**
@@ -96,45 +152,75 @@ namespace tobor {
 			}
 
 			/**
-			*	@brief Determines all possible predecessor states of \p state when the piece \p _piece_id was moved from \p _direction_from (i.e. into opposite direction compared to \p _direction_from).
+			*	@brief Writes all possible predecessor states of \p state when the piece \p _piece_id was moved from \p _direction_from (i.e. into opposite direction compared to \p _direction_from) to \p destination.
 			*
 			*	@details Note, if given piece may have come from a specified direction, but it is not able to stop at it's position according to \p state, then there is no predecessor.
+			*	@return Returns \p destination advanced by the number of predecessor states written.
 			*/
-			template<class Position_Of_Pieces_T>
-			inline std::vector<Position_Of_Pieces_T> predecessor_states(
+			template<class Position_Of_Pieces_T, class Iterator_T>
+			inline Iterator_T add_predecessor_states(
 				const Position_Of_Pieces_T& state,
 				const typename piece_move_type::piece_id_type& _piece_id,
-				const direction& _direction_from
+				const direction& _direction_from,
+				Iterator_T destination
 			) const {
-				const cell_id_type start_cell{ state.piece_positions()[_piece_id.value] };
-
-				const cell_id_int_type raw_start_cell_id{ start_cell.get_raw_id(_direction_from, board()) };
-
-				// need to check if we can stop here coming from _direction_from.
-				// return if there is no obstacle in opposite direction
-				if (next_cell_max_move_raw(raw_start_cell_id, state, !_direction_from) != raw_start_cell_id)
-					return std::vector<Position_Of_Pieces_T>();
+				visit_predecessor_states(state, _piece_id, _direction_from, [&](Position_Of_Pieces_T&& predecessor, const cell_id_type&) {
+					*destination = std::move(predecessor);
+					++destination;
+					});
+				return destination;
+			}
 
-				auto raw_far_id = next_cell_max_move_raw(
-					raw_start_cell_id,
-					state,
-					_direction_from
-				);
+			/**
+			*	@brief Writes all possible predecessor states of \p state when the piece \p _piece_id was moved in any direction to \p destination.
+			*	@return Returns \p destination advanced by the number of predecessor states written.
+			*/
+			template<class Position_Of_Pieces_T, class Iterator_T>
+			inline Iterator_T add_predecessor_states(
+				const Position_Of_Pieces_T& state,
+				const typename piece_move_type::piece_id_type& _piece_id,
+				Iterator_T destination
+			) const {
+				for (direction d = direction::begin(); d != direction::end(); ++d) {
+					destination = add_predecessor_states(state, _piece_id, d, destination);
+				}
+				return destination;
+			}
 
-				auto result = std::vector<Position_Of_Pieces_T>(
-					raw_start_cell_id > raw_far_id ?
-					raw_start_cell_id - raw_far_id :
-					raw_far_id - raw_start_cell_id,
-					state
-				);
+			/**
+			*	@brief Writes all possible predecessor states of \p state when any piece was moved in any direction to \p destination.
+			*	@return Returns \p destination advanced by the number of predecessor states written.
+			*/
+			template<class Position_Of_Pieces_T, class Iterator_T>
+			inline Iterator_T add_predecessor_states(const Position_Of_Pieces_T& state, Iterator_T destination) const {
+				for (piece_id_type piece = piece_id_type::begin(); piece != piece_id_type::end(); ++piece) {
+					destination = add_predecessor_states(state, piece, destination);
+				}
+				return destination;
+			}
 
-				const int8_t increment{ static_cast<int8_t>((raw_start_cell_id > raw_far_id) - (raw_start_cell_id < raw_far_id)) };
+			/**
+			*	@brief Returns an upper bound for the number of predecessor states of any single state.
+			*
+			*	@details Per piece, the predecessors coming from west and east lie on disjoint segments of one row, the same holds for north and south on one column.
+			*/
+			inline std::size_t max_count_predecessor_states() const noexcept {
+				return static_cast<std::size_t>(board().get_horizontal_size() + board().get_vertical_size()) * piece_id_type::pieces_quantity_type::COUNT_ALL_PIECES;
+			}
 
-				auto iter = result.begin();
-				for (cell_id_int_type raw_id = raw_far_id; raw_id != raw_start_cell_id; raw_id += increment, ++iter) {
-					iter->piece_positions()[_piece_id.value] = cell_id_type::create_by_raw_id(_direction_from, raw_id, board());
-					iter->sort_pieces();
-				}
+			/**
+			*	@brief Determines all possible predecessor states of \p state when the piece \p _piece_id was moved from \p _direction_from (i.e. into opposite direction compared to \p _direction_from).
+			*
+			*	@details Note, if given piece may have come from a specified direction, but it is not able to stop at it's position according to \p state, then there is no predecessor.
+			*/
+			template<class Position_Of_Pieces_T>
+			inline std::vector<Position_Of_Pieces_T> predecessor_states(
+				const Position_Of_Pieces_T& state,
+				const typename piece_move_type::piece_id_type& _piece_id,
+				const direction& _direction_from
+			) const {
+				auto result = std::vector<Position_Of_Pieces_T>();
+				add_predecessor_states(state, _piece_id, _direction_from, std::back_inserter(result));
 				return result;
 			}
 
@@ -149,10 +235,7 @@ namespace tobor {
 			) const {
 				auto result = std::vector<Position_Of_Pieces_T>();
 				result.reserve(static_cast<std::size_t>(board().get_horizontal_size() + board().get_vertical_size()));
-				for (direction d = direction::begin(); d != direction::end(); ++d) {
-					auto part = predecessor_states(state, _piece_id, d);
-					std::copy(std::begin(part), std::end(part), std::back_inserter(result));
-				}
+				add_predecessor_states(state, _piece_id, std::back_inserter(result));
 				if (SHRINK) result.shrink_to_fit();
 				return result;
 			}
@@ -163,17 +246,42 @@ namespace tobor {
 			template<class Position_Of_Pieces_T>
 			inline std::vector<Position_Of_Pieces_T> predecessor_states(const Position_Of_Pieces_T& state, const bool SHRINK = true) const {
 				auto result = std::vector<Position_Of_Pieces_T>();
-				result.reserve(
-					static_cast<std::size_t>(board().get_horizontal_size() + board().get_vertical_size()) * piece_id_type::pieces_quantity_type::COUNT_ALL_PIECES
-				);
-				for (piece_id_type piece = piece_id_type::begin(); piece != piece_id_type::end(); ++piece) {
-					auto part = predecessor_states(state, piece, false);
-					std::copy(std::begin(part), std::end(part), std::back_inserter(result));
-				}
+				result.reserve(max_count_predecessor_states());
+				add_predecessor_states(state, std::back_inserter(result));
 				if (SHRINK) result.shrink_to_fit();
 				return result;
 			}
-			// ### should add a function returning void but taking an insert iterator
+
+			/**
+			*	@brief Writes a predecessor_edge for every predecessor state of every state in [ \p first, \p last ) to \p destination.
+			*
+			*	@details The move of each edge refers to the piece ids of the predecessor state.
+			*	@return Returns \p destination advanced by the number of edges written.
+			*/
+			template<class Position_Of_Pieces_T, class Input_Iterator_T, class Iterator_T>
+			inline Iterator_T add_predecessor_edges(Input_Iterator_T first, Input_Iterator_T last, Iterator_T destination) const {
+				TOBOR_TRACE_SCOPE("move_engine::add_predecessor_edges");
+				for (; first != last; ++first) {
+					const Position_Of_Pieces_T& state{ *first };
+
+					for (piece_id_type piece = piece_id_type::begin(); piece != piece_id_type::end(); ++piece) {
+						for (direction d = direction::begin(); d != direction::end(); ++d) {
+							const direction move_direction{ !d };
+
+							visit_predecessor_states(state, piece, d, [&](Position_Of_Pieces_T&& predecessor, const cell_id_type& moved_piece_cell) {
+								// sorting may have changed the moved piece's id, so look it up in the predecessor:
+								const auto& positions{ predecessor.piece_positions() };
+								const auto moved_piece_id = static_cast<typename piece_id_type::int_type>(
+									std::find(positions.cbegin(), positions.cend(), moved_piece_cell) - positions.cbegin()
+									);
+								*destination = predecessor_edge<Position_Of_Pieces_T>(std::move(predecessor), state, piece_move_type(moved_piece_id, move_direction));
+								++destination;
+								});
+						}
+					}
+				}
+				return destination;
+			}
 
 			/**
 			*	@brief Calculates the successor state arising when moving \p _piece_id into direction \p _direction.
@@ -188,6 +296,25 @@ namespace tobor {
 				return result;
 			}
 
+			/**
+			*	@brief Calculates the successor state arising when moving \p _piece_id into direction \p _direction.
+			*	@details Updates \p zobrist_hash from the Zobrist hash of \p state to the one of the successor state, touching only the moved piece.
+			*/
+			template<class Position_Of_Pieces_T>
+			inline Position_Of_Pieces_T successor_state(const Position_Of_Pieces_T& state, const piece_id_type& _piece_id, const direction& _direction, uint64_t& zobrist_hash) const {
+				Position_Of_Pieces_T result(state);
+
+				const cell_id_type from{ state.piece_positions()[_piece_id.value] };
+				const cell_id_type to{ next_cell_max_move(from, state, _direction) };
+
+				result.piece_positions()[_piece_id.value] = to;
+				result.sort_pieces();
+
+				zobrist_hash = Position_Of_Pieces_T::zobrist_update(zobrist_hash, _piece_id.value < Position_Of_Pieces_T::COUNT_TARGET_PIECES, from, to);
+
+				return result;
+			}
+
 			/**
 			*	@brief Calculates the successor state arising when moving \p _piece_id into direction \p _direction.
 			*	@details Updates _piece_id to the new id the piece takes after is was moved.
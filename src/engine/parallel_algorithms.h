@@ -0,0 +1,60 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <version>
+
+#ifdef __cpp_lib_execution
+	#include <execution>
+#endif
+
+namespace tobor {
+	namespace v1_1 {
+
+		/**
+		*	@brief Standard algorithms with the parallel execution policy where the standard library provides one.
+		*
+		*	@details Falls back to the sequential algorithms where __cpp_lib_execution is missing,
+		*	like with the libc++ of AppleClang, which ships execution policies only with -fexperimental-library.
+		*/
+		namespace parallel {
+
+			/**
+			*	@brief Calls std::sort with the parallel execution policy if available.
+			*/
+			template<class ... Args_T>
+			inline void sort(Args_T&& ... args) {
+#ifdef __cpp_lib_execution
+				std::sort(std::execution::par, std::forward<Args_T>(args)...);
+#else
+				std::sort(std::forward<Args_T>(args)...);
+#endif
+			}
+
+			/**
+			*	@brief Calls std::for_each with the parallel execution policy if available.
+			*/
+			template<class ... Args_T>
+			inline void for_each(Args_T&& ... args) {
+#ifdef __cpp_lib_execution
+				std::for_each(std::execution::par, std::forward<Args_T>(args)...);
+#else
+				std::for_each(std::forward<Args_T>(args)...);
+#endif
+			}
+
+			/**
+			*	@brief Calls std::transform with the parallel execution policy if available.
+			*/
+			template<class ... Args_T>
+			inline auto transform(Args_T&& ... args) {
+#ifdef __cpp_lib_execution
+				return std::transform(std::execution::par, std::forward<Args_T>(args)...);
+#else
+				return std::transform(std::forward<Args_T>(args)...);
+#endif
+			}
+
+		}
+	}
+}
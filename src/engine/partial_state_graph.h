@@ -2,8 +2,12 @@
 
 #include "../models/legacy_move_path.h"
 
-#include <vector>
+#include <cstdint>
+#include <limits>
 #include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace tobor {
 	namespace v1_0 {
@@ -42,26 +46,43 @@ namespace tobor {
 				);
 
 
-			// all game states that have been found so far,
-			using partial_solutions_map_type = typename state_graph_node_type::partial_solutions_map_type;
-
-			using partial_solutions_map_mapped_type = typename partial_solutions_map_type::mapped_type;
-
-			// to be used as a pointer to a game state
-			using map_iterator = typename state_graph_node_type::map_iterator_type;
-
 			using size_type = typename state_graph_node_type::size_type;
 
 			using move_path_type = legacy_move_path<piece_move_type>;
 
 			static constexpr size_type SIZE_TYPE_MAX = state_graph_node_type::MAX;
 
-		private:
+			/** Index of a state inside the node arena */
+			using node_index_type = uint32_t;
+
+			static constexpr node_index_type NO_INDEX{ std::numeric_limits<node_index_type>::max() };
 
-		public:
-			partial_solutions_map_type ps_map; // should not be public anymore!
 		private:
 
+			/**
+			*	@brief Everything known about one state, except the state itself which is stored at the same index in _states.
+			*/
+			struct node_record {
+
+				node_index_type smallest_seen_step_distance_from_initial_state{ NO_INDEX };
+
+				node_index_type count_successors_where_this_is_one_optimal_predecessor{ 0 }; // is leaf iff == 0, warning: can be 0 before exploration or after
+
+				/** First and last element of the list of optimal predecessors in _predecessor_edges */
+				node_index_type first_predecessor_edge{ NO_INDEX };
+				node_index_type last_predecessor_edge{ NO_INDEX };
+
+				bool is_removed{ false };
+			};
+
+			/**
+			*	@brief Element of a singly linked list of optimal predecessors, all lists share the same pool.
+			*/
+			struct predecessor_edge {
+				node_index_type predecessor;
+				node_index_type next;
+				piece_move_type move;
+			};
 
 			// number of steps needed by any optimal solution
 			size_type optimal_path_length;
@@ -69,42 +90,116 @@ namespace tobor {
 			// initial state
 			positions_of_pieces_type initial_state;
 
+			// All game states that have been found so far, indexed by node_index_type.
+			std::vector<positions_of_pieces_type> _states;
+
+			std::vector<node_record> _nodes;
+
+			std::vector<predecessor_edge> _predecessor_edges;
+
+			// Open addressing hash table of node indices, linear probing, NO_INDEX marks empty slots. Size is a power of 2.
+			std::vector<node_index_type> _hash_slots;
+
 			// All game states that have been found yet, ordered by their shortest distance from initial state.
 			// .back() contains all game states to be explored if one deepening step just finished.
-			std::vector<std::vector<map_iterator>> visited_game_states;
+			std::vector<std::vector<node_index_type>> visited_game_states;
+
+			inline static std::size_t state_hash(const positions_of_pieces_type& state) {
+				std::size_t result{ 0 };
+				for (const auto& cell : state.piece_positions()) {
+					result = result * 0x9E3779B97F4A7C15ull + static_cast<std::size_t>(cell.get_id());
+				}
+				return result ^ (result >> 29);
+			}
+
+			inline void insert_into_hash_slots(const node_index_type& index) {
+				const std::size_t MASK{ _hash_slots.size() - 1 };
+				std::size_t slot{ state_hash(_states[index]) & MASK };
+				while (_hash_slots[slot] != NO_INDEX) {
+					slot = (slot + 1) & MASK;
+				}
+				_hash_slots[slot] = index;
+			}
+
+			/**
+			*	@brief Returns the index of \p state, and whether it has been inserted, i.e. not been contained before.
+			*/
+			inline std::pair<node_index_type, bool> find_or_insert(const positions_of_pieces_type& state) {
+				if (2 * (_states.size() + 1) > _hash_slots.size()) { // keep load factor <= 1/2
+					_hash_slots.assign(_hash_slots.empty() ? std::size_t(1024) : 2 * _hash_slots.size(), NO_INDEX);
+					for (std::size_t index{ 0 }; index < _states.size(); ++index) {
+						insert_into_hash_slots(static_cast<node_index_type>(index));
+					}
+				}
+
+				const std::size_t MASK{ _hash_slots.size() - 1 };
+				std::size_t slot{ state_hash(state) & MASK };
+				while (_hash_slots[slot] != NO_INDEX) {
+					if (_states[_hash_slots[slot]] == state) {
+						return std::make_pair(_hash_slots[slot], false);
+					}
+					slot = (slot + 1) & MASK;
+				}
+
+				if (!(_states.size() < NO_INDEX)) {
+					throw std::length_error("partial_state_graph: too many states for node_index_type");
+				}
+
+				const node_index_type index{ static_cast<node_index_type>(_states.size()) };
+				_states.push_back(state);
+				_nodes.emplace_back();
+				_hash_slots[slot] = index;
+				return std::make_pair(index, true);
+			}
+
+			inline void add_optimal_predecessor(const node_index_type& node, const node_index_type& predecessor, const piece_move_type& move) {
+				if (!(_predecessor_edges.size() < NO_INDEX)) {
+					throw std::length_error("partial_state_graph: too many edges for node_index_type");
+				}
+
+				const node_index_type edge{ static_cast<node_index_type>(_predecessor_edges.size()) };
+				_predecessor_edges.push_back(predecessor_edge{ predecessor, NO_INDEX, move });
+
+				node_record& record{ _nodes[node] };
+				if (record.last_predecessor_edge == NO_INDEX) {
+					record.first_predecessor_edge = edge;
+				}
+				else {
+					_predecessor_edges[record.last_predecessor_edge].next = edge;
+				}
+				record.last_predecessor_edge = edge;
+
+				++_nodes[predecessor].count_successors_where_this_is_one_optimal_predecessor;
+			}
 
 			template<class Insert_Iterator>
-			inline void optimal_move_path_helper_back_to_front(map_iterator state, Insert_Iterator destination, const move_path_type& path_suffix = move_path_type()) {
+			inline void optimal_move_path_helper_back_to_front(const node_index_type& state, Insert_Iterator destination, const move_path_type& path_suffix = move_path_type()) {
 
-				if (state->second.smallest_seen_step_distance_from_initial_state == 0) {
+				if (_nodes[state].smallest_seen_step_distance_from_initial_state == 0) {
 					destination = path_suffix;
 				}
 
-				for (auto& tuple : state->second.optimal_predecessors) {
+				for (node_index_type edge = _nodes[state].first_predecessor_edge; edge != NO_INDEX; edge = _predecessor_edges[edge].next) {
 
-					auto& predecessor_map_iterator{ std::get<0>(tuple) };
-					auto& move{ std::get<1>(tuple) };
+					const node_index_type predecessor{ _predecessor_edges[edge].predecessor };
 					move_path_type path(path_suffix.vector().size() + 1);
-					path.vector()[0] = move;
+					path.vector()[0] = _predecessor_edges[edge].move;
 					std::copy(path_suffix.vector().cbegin(), path_suffix.vector().cend(), path.vector().begin() + 1);
 
-					optimal_move_path_helper_back_to_front(predecessor_map_iterator, destination, path);
+					optimal_move_path_helper_back_to_front(predecessor, destination, path);
 				}
 			}
 
 		public:
 
-
-			// ### note in case of removing states with no optimal successors, the invalid iterator problem arises.
 			partial_state_graph(const positions_of_pieces_type& initial_state) :
 				optimal_path_length(SIZE_TYPE_MAX),
 				initial_state(initial_state)
 			{
-				ps_map[initial_state].smallest_seen_step_distance_from_initial_state = 0; // insert initial state into map
-				//ps_map[initial_state].count_successors_where_this_is_one_optimal_predecessor; -> default 0
-				//ps_map[initial_state].optimal_predecessors; -> default empty vector
+				const node_index_type initial_index{ find_or_insert(initial_state).first }; // insert initial state
+				_nodes[initial_index].smallest_seen_step_distance_from_initial_state = 0;
 
-				visited_game_states.push_back(std::vector<map_iterator>{ps_map.begin()}); // insert initial state into visited states
+				visited_game_states.push_back(std::vector<node_index_type>{ initial_index }); // insert initial state into visited states
 			}
 
 			partial_state_graph(
@@ -120,33 +215,28 @@ namespace tobor {
 
 			inline size_type get_optimal_path_length() { return optimal_path_length; };
 
-			inline std::vector<map_iterator> optimal_final_state_iterators(const cell_id_type& target_cell) const {
-				std::vector<map_iterator> result;
-				for (const auto& iter : visited_game_states.back()) {
-					if (iter->first.is_final(target_cell)) {
-						result.push_back(iter);
+			/**
+			*	@brief Returns the number of states found so far, including removed ones.
+			*/
+			inline size_type count_states() const { return _states.size(); }
+
+			inline const positions_of_pieces_type& state(const node_index_type& index) const { return _states[index]; }
+
+			inline std::vector<node_index_type> optimal_final_state_indices(const cell_id_type& target_cell) const {
+				std::vector<node_index_type> result;
+				for (const auto& index : visited_game_states.back()) {
+					if (_states[index].is_final(target_cell)) {
+						result.push_back(index);
 					}
 				}
 				return result;
 			}
 
-			/*
-			inline std::vector<map_iterator> optimal_distance_dead_state_iterators(const cell_id_type& target_cell) const {
-				//std::vector<map_iterator> result;
-				//for (const auto& iter : visited_game_states.back()) {
-				//	if (iter->first.is_final(target_cell)) {
-				//		result.push_back(iter);
-				//	}
-				//}
-				//return result;
-			}
-			*/
-
 			inline std::vector<positions_of_pieces_type> optimal_final_states(const cell_id_type& target_cell) const {
 				std::vector<positions_of_pieces_type> result;
-				for (const auto& iter : visited_game_states.back()) {
-					if (iter->first.is_final(target_cell)) {
-						result.push_back(iter->first);
+				for (const auto& index : visited_game_states.back()) {
+					if (_states[index].is_final(target_cell)) {
+						result.push_back(_states[index]);
 					}
 				}
 				return result;
@@ -154,57 +244,58 @@ namespace tobor {
 
 			inline std::map<positions_of_pieces_type, std::vector<move_path_type>> optimal_move_paths(const cell_id_type& target_cell) {
 				std::map<positions_of_pieces_type, std::vector<move_path_type>> result;
-				for (auto iter = ps_map.begin(); iter != ps_map.end(); ++iter) {
-					auto& state{ iter->first };
-					if (state.is_final(target_cell)) {
-						optimal_move_path_helper_back_to_front(iter, std::back_inserter(result[state]));
+				for (std::size_t index{ 0 }; index < _states.size(); ++index) {
+					const auto& state{ _states[index] };
+					if (!_nodes[index].is_removed && state.is_final(target_cell)) {
+						optimal_move_path_helper_back_to_front(static_cast<node_index_type>(index), std::back_inserter(result[state]));
 					}
 				}
 				return result;
 			}
 
-
-			inline void remove_dead_states(const std::vector<map_iterator>& live_states) {
-				for (const auto& map_it : live_states) {
-					++map_it->second.count_successors_where_this_is_one_optimal_predecessor;
+			/**
+			*	@brief Marks all states as removed which do not lie on an optimal path to some state of \p live_states.
+			*
+			*	@details Removed states keep their place in the arena, they are only skipped by optimal_move_paths().
+			*/
+			inline void remove_dead_states(const std::vector<node_index_type>& live_states) {
+				for (const auto& index : live_states) {
+					++_nodes[index].count_successors_where_this_is_one_optimal_predecessor;
 				}
-				std::vector<map_iterator> to_be_removed; // all iterators pointing to states where:   count_successors_where_this_is_one_optimal_predecessor == 0
+				std::vector<node_index_type> to_be_removed; // all states where:   count_successors_where_this_is_one_optimal_predecessor == 0
 
-				for (auto iter = ps_map.begin(); iter != ps_map.end(); ++iter) {
-					if (iter->second.count_successors_where_this_is_one_optimal_predecessor == 0) {
-						to_be_removed.push_back(iter);
+				for (std::size_t index{ 0 }; index < _nodes.size(); ++index) {
+					if (!_nodes[index].is_removed && _nodes[index].count_successors_where_this_is_one_optimal_predecessor == 0) {
+						to_be_removed.push_back(static_cast<node_index_type>(index));
 					}
 				}
 
 				while (!to_be_removed.empty()) {
-					map_iterator removee = to_be_removed.back();
+					const node_index_type removee = to_be_removed.back();
 					to_be_removed.pop_back();
 
-					for (auto iter = removee->second.optimal_predecessors.begin(); iter != removee->second.optimal_predecessors.end(); ++iter) {
-						auto& pred{ std::get<0>(*iter) };
-						--pred->second.count_successors_where_this_is_one_optimal_predecessor;
-						if (pred->second.count_successors_where_this_is_one_optimal_predecessor == 0) {
+					for (node_index_type edge = _nodes[removee].first_predecessor_edge; edge != NO_INDEX; edge = _predecessor_edges[edge].next) {
+						const node_index_type pred{ _predecessor_edges[edge].predecessor };
+						--_nodes[pred].count_successors_where_this_is_one_optimal_predecessor;
+						if (_nodes[pred].count_successors_where_this_is_one_optimal_predecessor == 0) {
 							to_be_removed.push_back(pred);
 						}
 					}
 
-					ps_map.erase(removee);
+					_nodes[removee].is_removed = true;
+					_nodes[removee].first_predecessor_edge = NO_INDEX;
+					_nodes[removee].last_predecessor_edge = NO_INDEX;
 				}
 
-				for (const auto& map_it : live_states) {
-					--map_it->second.count_successors_where_this_is_one_optimal_predecessor;
+				for (const auto& index : live_states) {
+					--_nodes[index].count_successors_where_this_is_one_optimal_predecessor;
 				}
 			}
 
 			inline void remove_dead_states(const cell_id_type& target_cell_defining_live_states) {
-				return remove_dead_states(optimal_final_state_iterators(target_cell_defining_live_states));
+				return remove_dead_states(optimal_final_state_indices(target_cell_defining_live_states));
 			}
 
-			//inline void remove_dead_states2(const std::vector<map_iterator>& dead_states = ) {
-			//	//...
-			//}
-
-
 			// ### offer step-wise exploration instead of exploration until optimal.
 			inline void explore_until_optimal_solution_distance(
 				move_one_piece_calculator_type& engine,
@@ -219,7 +310,7 @@ namespace tobor {
 					return;
 				}
 
-				if (visited_game_states[0][0]->first.is_final(target_cell)) {
+				if (_states[visited_game_states[0][0]].is_final(target_cell)) {
 					optimal_path_length = 0;
 					return;
 				}
@@ -237,7 +328,9 @@ namespace tobor {
 
 					for (std::size_t expand_index_inside_level = 0; expand_index_inside_level < visited_game_states[expand_level_index].size(); ++expand_index_inside_level) {
 
-						const map_iterator& current_iterator{ visited_game_states[expand_level_index][expand_index_inside_level] };
+						const node_index_type current_index{ visited_game_states[expand_level_index][expand_index_inside_level] };
+
+						const size_type CURRENT_DISTANCE{ _nodes[current_index].smallest_seen_step_distance_from_initial_state };
 
 						std::vector<move_candidate> candidates_for_successor_states; // can be array with fixed size(?)
 
@@ -246,7 +339,7 @@ namespace tobor {
 							for (direction direction_iter = direction::begin(); direction_iter < direction::end(); ++direction_iter) {
 								candidates_for_successor_states.emplace_back(
 									piece_move_type(pid, direction_iter),
-									engine.successor_state(current_iterator->first, pid, direction_iter)
+									engine.successor_state(_states[current_index], pid, direction_iter)
 								);
 							}
 						}
@@ -274,14 +367,14 @@ namespace tobor {
 							if constexpr (positions_of_pieces_type::SORTED_TARGET_PIECES) {
 
 								if (candidates_for_successor_states[index_candidate].successor_state.is_final(target_cell)) {
-									optimal_path_length = current_iterator->second.smallest_seen_step_distance_from_initial_state + 1;
+									optimal_path_length = CURRENT_DISTANCE + 1;
 								}
 
 							}
 							else {
 								if (candidates_for_successor_states[index_candidate].successor_state.piece_positions()[index_candidate / 4] == target_cell) {
 									// does not work for sorted final pieces! In that case we do not know where the moved piece is located.
-									optimal_path_length = current_iterator->second.smallest_seen_step_distance_from_initial_state + 1;
+									optimal_path_length = CURRENT_DISTANCE + 1;
 								}
 							}
 						}
@@ -290,74 +383,26 @@ namespace tobor {
 						for (auto& c : candidates_for_successor_states) {
 							if (c.is_true_move) { // there is a real move
 
-								auto [iter_insertion, bool_inserted] = ps_map.insert(std::make_pair(c.successor_state, partial_solutions_map_mapped_type()));
-								// Note: on entry creation default distance from 
-
-
-								// iter_insertion is the iterator to the inserted map entry or the one which prevented insertion.
-
-								auto& entry_value{ iter_insertion->second };
+								const auto [successor_index, inserted] = find_or_insert(c.successor_state);
 
 								// check if path to successor state is an optimal one (as far as we have seen):
-								if (
-									current_iterator->second.smallest_seen_step_distance_from_initial_state + 1
-									<
-									entry_value.smallest_seen_step_distance_from_initial_state
-									)
-								{
-									/*
-										This IF is asking whether the current state is now found via a shorter path than before:
-											* We need to do this, if it is possible to find better paths later when a state has already been reached before
-												* This never happens here, since we expand states ordered by their distance from init
-											* We check here because the default distance is some MAX value.
-												* if we find the state for the first time, we compare the optimal distance with the default MAX.
-									*/
-
-									// this whole IF therefore might be replaced by asking for the value of bool_inserted! <<<<<
-
-									/*
-										delete all predecessors -> not needed, because we know vector is empty
-											-> will be needed if we stop relying on the expand-order
-									*/
-
-
-									// set optimal distance seen so far: // here it is assured to be the shortest distance from init:
-									entry_value.smallest_seen_step_distance_from_initial_state = current_iterator->second.smallest_seen_step_distance_from_initial_state + 1;
+								if (inserted) {
+									// Since states are expanded ordered by their distance from init, a state found for the first time is found via a shortest path.
 
+									_nodes[successor_index].smallest_seen_step_distance_from_initial_state = static_cast<node_index_type>(CURRENT_DISTANCE + 1);
 
 									// add the current expandee as optimal predecessor:
-									entry_value.optimal_predecessors.reserve(16); // ### if we do not shrink later this consumes more memory than needed.
-									// <<<< we might collect statistics about typical vector sizes.
-									entry_value.optimal_predecessors.emplace_back(current_iterator, c.move);
-
-
-									// ++ optimal successor counter for expandee:
-									++(current_iterator->second.count_successors_where_this_is_one_optimal_predecessor);
-
+									add_optimal_predecessor(successor_index, current_index, c.move);
 
 									// add newly discovered state to the vector of states to expand in the next round:
-									visited_game_states[expand_level_index + 1].push_back(iter_insertion);
+									visited_game_states[expand_level_index + 1].push_back(successor_index);
 								}
 								else {
-									if (
-										entry_value.smallest_seen_step_distance_from_initial_state
-										==
-										current_iterator->second.smallest_seen_step_distance_from_initial_state + 1
-										)
-									{
-										/*
-											Check for:
-											* The state has already been found with the same distance from init
-										*/
-
+									if (_nodes[successor_index].smallest_seen_step_distance_from_initial_state == CURRENT_DISTANCE + 1) {
+										// The state has already been found with the same distance from init
 
 										// add the current expandee as optimal predecessor:
-										entry_value.optimal_predecessors.emplace_back(current_iterator, c.move);
-
-
-										// ++ optimal successor counter for expandee:
-										++(current_iterator->second.count_successors_where_this_is_one_optimal_predecessor);
-
+										add_optimal_predecessor(successor_index, current_index, c.move);
 									}
 								}
 							}
@@ -3,6 +3,9 @@
 #include "../models/state_path.h"
 #include "../models/simple_state_digraph.h"
 
+#include <iterator>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 namespace tobor {
@@ -241,10 +244,7 @@ namespace tobor {
 
 				for (const auto& pair : source.map) {
 					if (contains(pair.second.labels, label_index)) {
-						auto iter = destination.map.insert(
-							destination.map.end(),
-							std::make_pair(pair.first, typename simple_state_digraph<positions_of_pieces_type, State_Label_T>::node_links())
-						);
+						auto iter = destination.map.emplace_hint(destination.map.end(), std::piecewise_construct, std::forward_as_tuple(pair.first), std::forward_as_tuple());
 						std::copy_if(pair.second.predecessors.cbegin(), pair.second.predecessors.cend(), std::inserter(iter->second.predecessors, iter->second.predecessors.end()), has_label);
 						std::copy_if(pair.second.successors.cbegin(), pair.second.successors.cend(), std::inserter(iter->second.successors, iter->second.successors.end()), has_label);
 					}
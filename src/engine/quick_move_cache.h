@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <bit>
+#include <cstddef>
 #include <vector>
 
 namespace tobor {
@@ -21,19 +24,71 @@ namespace tobor {
 			using int_size_type = typename world_type::int_size_type;
 
 		private:
+
+			/**
+			*	@brief Quick move targets stored for one raw id i.
+			*	@details WEST and EAST refer to the cell with id i, SOUTH and NORTH to the cell with transposed id i. Values are raw ids of the same kind.
+			*/
+			struct jump_targets {
+				std::array<int_cell_id_type, 4> target;
+			};
+
+			// slot of direction d is the position of d's encoding bit
+			static constexpr std::size_t NORTH_SLOT{ 0 };
+			static constexpr std::size_t EAST_SLOT{ 1 };
+			static constexpr std::size_t SOUTH_SLOT{ 2 };
+			static constexpr std::size_t WEST_SLOT{ 3 };
+
+			static_assert(direction::encoding::NORTH == 1 << NORTH_SLOT, "quick_move_cache: NORTH slot mismatch");
+			static_assert(direction::encoding::EAST == 1 << EAST_SLOT, "quick_move_cache: EAST slot mismatch");
+			static_assert(direction::encoding::SOUTH == 1 << SOUTH_SLOT, "quick_move_cache: SOUTH slot mismatch");
+			static_assert(direction::encoding::WEST == 1 << WEST_SLOT, "quick_move_cache: WEST slot mismatch");
+
 			const world_type& _board;
 
-			std::vector<int_cell_id_type> go_west; // using cell ids
-			std::vector<int_cell_id_type> go_east; // using cell ids
-			std::vector<int_cell_id_type> go_south; // using transposed cell ids
-			std::vector<int_cell_id_type> go_north; // using transposed cell ids
+			std::vector<jump_targets> _jumps; // interleaved, indexed by raw id
+
+			/**
+			*	@brief Recomputes the quick moves crossing the boundary between raw ids \p boundary - 1 and \p boundary.
+			*
+			*	@details \p has_wall(k) tells whether there is a wall between raw ids k - 1 and k for 0 < k < count_cells().
+			*	Only the segment between the walls next to \p boundary is written.
+			*/
+			template<class Has_Wall_T>
+			void update_segment(std::size_t boundary, std::size_t lower_slot, std::size_t upper_slot, Has_Wall_T&& has_wall) {
+				const std::size_t COUNT{ _jumps.size() };
+
+				auto wall_at = [&](std::size_t k) {
+					return k == 0 || k >= COUNT || has_wall(k);
+				};
+
+				// moving to lower raw ids, cells from boundary up to the next wall:
+				if (boundary < COUNT) {
+					const int_cell_id_type target{ wall_at(boundary) ? static_cast<int_cell_id_type>(boundary) : _jumps[boundary - 1].target[lower_slot] };
+					std::size_t k{ boundary };
+					do {
+						_jumps[k].target[lower_slot] = target;
+						++k;
+					} while (!wall_at(k));
+				}
+
+				// moving to higher raw ids, cells from boundary - 1 down to the previous wall:
+				if (boundary > 0) {
+					const int_cell_id_type target{ wall_at(boundary) ? static_cast<int_cell_id_type>(boundary - 1) : _jumps[boundary].target[upper_slot] };
+					std::size_t k{ boundary };
+					do {
+						--k;
+						_jumps[k].target[upper_slot] = target;
+					} while (!wall_at(k));
+				}
+			}
 
 		public:
 
 			/**
 			*	@brief Calculates quick moves for all cells of board. Make sure that reference to \p board stays valid until this is destroyed. Otherwise behavior is undefined.
 			*
-			*	@details Make sure that for this cache to be correct, update() needs to be called whenever board is changed.
+			*	@details Make sure that for this cache to be correct, update() or update_wall() needs to be called whenever board is changed.
 			*/
 			quick_move_cache(const world_type& board) : _board(board) {
 				update();
@@ -47,56 +102,74 @@ namespace tobor {
 			void update() {
 				const int_size_type VECTOR_SIZE{ _board.count_cells() };
 
+				_jumps.assign(VECTOR_SIZE, jump_targets{});
+
 				if (!(VECTOR_SIZE > 0)) {
 					return;
 				}
 
-				go_west = std::vector<int_cell_id_type>(VECTOR_SIZE, 0);
-				go_east = std::vector<int_cell_id_type>(VECTOR_SIZE, 0);
-				go_south = std::vector<int_cell_id_type>(VECTOR_SIZE, 0);
-				go_north = std::vector<int_cell_id_type>(VECTOR_SIZE, 0);
-
 				{
-					go_west[0] = 0;
-					go_south[0] = 0;
+					_jumps[0].target[WEST_SLOT] = 0;
+					_jumps[0].target[SOUTH_SLOT] = 0;
 
 					int_cell_id_type id = 0;
 					while (static_cast<int_size_type>(id) + 1 < VECTOR_SIZE) {
 						++id;
 						if (_board.west_wall_by_id(id)) {
-							go_west[id] = id;
+							_jumps[id].target[WEST_SLOT] = id;
 						}
 						else {
-							go_west[id] = go_west[id - 1];
+							_jumps[id].target[WEST_SLOT] = _jumps[id - 1].target[WEST_SLOT];
 						}
 						if (_board.south_wall_by_transposed_id(id)) {
-							go_south[id] = id;
+							_jumps[id].target[SOUTH_SLOT] = id;
 						}
 						else {
-							go_south[id] = go_south[id - 1];
+							_jumps[id].target[SOUTH_SLOT] = _jumps[id - 1].target[SOUTH_SLOT];
 						}
 					}
 				}
 				{
-					go_east[VECTOR_SIZE - 1] = static_cast<int_cell_id_type>(VECTOR_SIZE - 1);
-					go_north[VECTOR_SIZE - 1] = static_cast<int_cell_id_type>(VECTOR_SIZE - 1);
+					_jumps[VECTOR_SIZE - 1].target[EAST_SLOT] = static_cast<int_cell_id_type>(VECTOR_SIZE - 1);
+					_jumps[VECTOR_SIZE - 1].target[NORTH_SLOT] = static_cast<int_cell_id_type>(VECTOR_SIZE - 1);
 
 					int_cell_id_type id{ static_cast<int_cell_id_type>(VECTOR_SIZE - 1) };
-					do {
+					while (id != 0) {
 						--id;
 						if (_board.east_wall_by_id(id)) {
-							go_east[id] = id;
+							_jumps[id].target[EAST_SLOT] = id;
 						}
 						else {
-							go_east[id] = go_east[id + 1];
+							_jumps[id].target[EAST_SLOT] = _jumps[id + 1].target[EAST_SLOT];
 						}
 						if (_board.north_wall_by_transposed_id(id)) {
-							go_north[id] = id;
+							_jumps[id].target[NORTH_SLOT] = id;
 						}
 						else {
-							go_north[id] = go_north[id + 1];
+							_jumps[id].target[NORTH_SLOT] = _jumps[id + 1].target[NORTH_SLOT];
 						}
-					} while (id != 0);
+					}
+				}
+			}
+
+			/**
+			*	@brief Updates the cache after the wall of cell \p id on side \p d has been set or removed on the board.
+			*
+			*	@details Only recomputes the quick moves of the row or column segment touching that wall.
+			*	The board's size must not have changed since the last call of update(). Walls on the board's outer border are always treated as existing.
+			*/
+			void update_wall(int_cell_id_type id, const direction& d) {
+				if (d.is_id_direction()) {
+					const std::size_t boundary{ static_cast<std::size_t>(id) + (d.get() == direction::encoding::EAST) };
+					update_segment(boundary, WEST_SLOT, EAST_SLOT, [&](std::size_t k) {
+						return _board.west_wall_by_id(static_cast<int_cell_id_type>(k));
+						});
+				}
+				else if (d.is_transposed_id_direction()) {
+					const std::size_t boundary{ static_cast<std::size_t>(_board.cell_id_to_transposed_cell_id(id)) + (d.get() == direction::encoding::NORTH) };
+					update_segment(boundary, SOUTH_SLOT, NORTH_SLOT, [&](std::size_t k) {
+						return _board.south_wall_by_transposed_id(static_cast<int_cell_id_type>(k));
+						});
 				}
 			}
 
@@ -104,25 +177,25 @@ namespace tobor {
 			* @brief Returns the id of the cell you reach from cell \p id when moving west with no pieces on the way.
 			* @details Has undefined behavior if \p id is out of range. Valid range is [ 0, _board.count_cells() - 1 ]
 			*/
-			inline int_cell_id_type get_west(int_cell_id_type id) const { return go_west[id]; }
+			inline int_cell_id_type get_west(int_cell_id_type id) const { return _jumps[id].target[WEST_SLOT]; }
 
 			/**
 			* @brief Returns the id of the cell you reach from cell \p id when moving east with no pieces on the way.
 			* @details Has undefined behavior if \p id is out of range. Valid range is [ 0, _board.count_cells() - 1 ]
 			*/
-			inline int_cell_id_type get_east(int_cell_id_type id) const { return go_east[id]; }
+			inline int_cell_id_type get_east(int_cell_id_type id) const { return _jumps[id].target[EAST_SLOT]; }
 
 			/**
 			* @brief Returns the transposed id of the cell you reach from cell \p transposed_id when moving south with no pieces on the way.
 			* @details Has undefined behavior if \p id is out of range. Valid range is [ 0, _board.count_cells() - 1 ]
 			*/
-			inline int_cell_id_type get_south(int_cell_id_type transposed_id) const { return go_south[transposed_id]; }
+			inline int_cell_id_type get_south(int_cell_id_type transposed_id) const { return _jumps[transposed_id].target[SOUTH_SLOT]; }
 
 			/**
 			* @brief Returns the transposed id of the cell you reach from cell \p transposed_id when moving north with no pieces on the way.
 			* @details Has undefined behavior if \p id is out of range. Valid range is [ 0, _board.count_cells() - 1 ]
 			*/
-			inline int_cell_id_type get_north(int_cell_id_type transposed_id) const { return go_north[transposed_id]; }
+			inline int_cell_id_type get_north(int_cell_id_type transposed_id) const { return _jumps[transposed_id].target[NORTH_SLOT]; }
 
 			/**
 			*	@brief Returns the raw id of the cell you reach from cell \p id when moving in direction \p d, assuming there are no pieces on the way.
@@ -132,19 +205,10 @@ namespace tobor {
 			*		Has undefined behavior if \p id is out of range. Valid range is [ 0, _board.count_cells() - 1 ].
 			*/
 			inline int_cell_id_type get(const direction& d, int_cell_id_type raw_id) const {
-				switch (d.get())
-				{
-				case direction::encoding::NORTH:
-					return get_north(raw_id);
-				case direction::encoding::EAST:
-					return get_east(raw_id);
-				case direction::encoding::SOUTH:
-					return get_south(raw_id);
-				case direction::encoding::WEST:
-					return get_west(raw_id);
-				default:
-					return raw_id;
+				if (d.get() & (direction::encoding::NORTH | direction::encoding::EAST | direction::encoding::SOUTH | direction::encoding::WEST)) {
+					return _jumps[raw_id].target[std::countr_zero(static_cast<unsigned int>(d.get()))];
 				}
+				return raw_id;
 			}
 		};
 
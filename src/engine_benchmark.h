@@ -0,0 +1,148 @@
+#pragma once
+
+#include "engine_typeset.h"
+#include "world_generator_1_1.h"
+
+#include "engine/distance_exploration.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+*	@brief Solves the same original game with the 8 bit cell id ClassicEngineTypeSet and the 16 bit cell id LargeBoardEngineTypeSet, and compares memory and throughput.
+*/
+template<class Pieces_Quantity_T>
+class EngineBenchmark {
+public:
+
+	using pieces_quantity_type = Pieces_Quantity_T;
+
+	using classic_typeset = ClassicEngineTypeSet<pieces_quantity_type>;
+
+	using large_board_typeset = LargeBoardEngineTypeSet<pieces_quantity_type>;
+
+	using board_generator_type = tobor::v1_1::world_generator::original_4_of_16;
+
+	using state_generator_type = tobor::v1_1::world_generator::initial_state_generator<
+		typename classic_typeset::positions_of_pieces_type_interactive,
+		256,
+		pieces_quantity_type::COUNT_TARGET_PIECES,
+		pieces_quantity_type::COUNT_NON_TARGET_PIECES,
+		4>;
+
+	/**
+	*	@brief Measurement of one engine type set.
+	*/
+	struct result {
+		std::string name;
+		std::size_t cell_id_bytes;
+		std::size_t state_bytes;
+		std::size_t optimal_length; // SIZE_MAX if not found within max depth
+		std::size_t count_states;
+		std::size_t explored_bytes; // count_states * state_bytes
+		double seconds; // best of all repetitions
+
+		inline double states_per_second() const noexcept { return seconds > 0 ? static_cast<double>(count_states) / seconds : 0; }
+	};
+
+private:
+
+	template<class Engine_Type_Set_T>
+	static typename Engine_Type_Set_T::cell_id_type converted_cell(const typename classic_typeset::cell_id_type& cell, const typename classic_typeset::world_type& world, const typename Engine_Type_Set_T::world_type& converted) {
+		using int_cell_id_type = typename Engine_Type_Set_T::cell_id_type::int_cell_id_type;
+		return Engine_Type_Set_T::cell_id_type::create_by_coordinates(
+			static_cast<int_cell_id_type>(cell.get_x_coord(world)),
+			static_cast<int_cell_id_type>(cell.get_y_coord(world)),
+			converted
+		);
+	}
+
+	template<class Engine_Type_Set_T>
+	static typename Engine_Type_Set_T::world_type converted_world(const typename classic_typeset::world_type& world) {
+		using cell_id_type = typename classic_typeset::cell_id_type;
+
+		typename Engine_Type_Set_T::world_type converted(world.get_horizontal_size(), world.get_vertical_size());
+
+		for (std::size_t i{ 0 }; i < world.count_cells(); ++i) {
+			const auto cell{ cell_id_type::create_by_id(static_cast<typename cell_id_type::int_cell_id_type>(i), world) };
+			const auto converted_cell_id{ converted_cell<Engine_Type_Set_T>(cell, world, converted) };
+			converted.west_wall_by_id(converted_cell_id.get_id()) = world.west_wall_by_id(cell.get_id());
+			converted.east_wall_by_id(converted_cell_id.get_id()) = world.east_wall_by_id(cell.get_id());
+			converted.south_wall_by_transposed_id(converted_cell_id.get_transposed_id(converted)) = world.south_wall_by_transposed_id(cell.get_transposed_id(world));
+			converted.north_wall_by_transposed_id(converted_cell_id.get_transposed_id(converted)) = world.north_wall_by_transposed_id(cell.get_transposed_id(world));
+		}
+		return converted;
+	}
+
+	template<class Engine_Type_Set_T>
+	static result measure(
+		const std::string& name,
+		const typename classic_typeset::world_type& world,
+		const typename classic_typeset::positions_of_pieces_type_solver& initial_state,
+		const typename classic_typeset::cell_id_type& target_cell,
+		const std::size_t& max_depth,
+		const std::size_t& repetitions
+	) {
+		using positions_of_pieces_type = typename Engine_Type_Set_T::positions_of_pieces_type_solver;
+		using distance_exploration_type = tobor::v1_1::distance_exploration<typename Engine_Type_Set_T::move_engine_type, positions_of_pieces_type>;
+
+		const auto converted{ converted_world<Engine_Type_Set_T>(world) };
+		const typename Engine_Type_Set_T::move_engine_type engine(converted);
+
+		std::array<typename Engine_Type_Set_T::cell_id_type, pieces_quantity_type::COUNT_ALL_PIECES> cells;
+		std::transform(initial_state.piece_positions().cbegin(), initial_state.piece_positions().cend(), cells.begin(), [&](const auto& cell) {
+			return converted_cell<Engine_Type_Set_T>(cell, world, converted);
+			});
+		const positions_of_pieces_type converted_initial_state(cells.cbegin());
+		const auto converted_target_cell{ converted_cell<Engine_Type_Set_T>(target_cell, world, converted) };
+
+		result r{ name, sizeof(typename Engine_Type_Set_T::cell_id_type::int_cell_id_type), sizeof(positions_of_pieces_type), 0, 0, 0, std::numeric_limits<double>::max() };
+
+		for (std::size_t i{ 0 }; i < std::max<std::size_t>(repetitions, 1); ++i) {
+			distance_exploration_type explorer(converted_initial_state);
+
+			const auto start{ std::chrono::steady_clock::now() };
+			const std::size_t length{ explorer.explore_until_target(engine, converted_target_cell, max_depth) };
+			const std::chrono::duration<double> duration{ std::chrono::steady_clock::now() - start };
+
+			r.optimal_length = length == distance_exploration_type::SIZE_TYPE_MAX ? std::numeric_limits<std::size_t>::max() : length;
+			r.count_states = explorer.count_states();
+			r.seconds = std::min(r.seconds, duration.count());
+		}
+		r.explored_bytes = r.count_states * r.state_bytes;
+		return r;
+	}
+
+public:
+
+	/**
+	*	@brief Explores the original game given by the generator counters until its target, but not beyond \p max_depth, \p repetitions times with each engine type set.
+	*
+	*	@return Returns the results of the 8 bit and the 16 bit cell id engine type sets, in this order.
+	*/
+	static std::vector<result> run(
+		const uint64_t& world_generator_counter,
+		const uint64_t& state_generator_counter,
+		const std::size_t& repetitions,
+		const std::size_t& max_depth = std::numeric_limits<std::size_t>::max()
+	) {
+		board_generator_type board_generator(world_generator_counter);
+
+		state_generator_type state_generator;
+		state_generator.set_counter(state_generator_counter);
+
+		const auto world{ board_generator.get_tobor_world() };
+		const auto target_cell{ board_generator.get_target_cell() };
+		const auto initial_state{ state_generator.get_positions_of_pieces(world).naked() };
+
+		return {
+			measure<classic_typeset>("8 bit cell ids", world, initial_state, target_cell, max_depth, repetitions),
+			measure<large_board_typeset>("16 bit cell ids", world, initial_state, target_cell, max_depth, repetitions)
+		};
+	}
+};
@@ -7,12 +7,18 @@
 #include "engine/quick_move_cache.h"
 #include "engine/move_engine.h"
 #include "models/move_path.h"
+#include "models/compact_state_path.h"
 
 
-template<class Pieces_Quantity_T>
+/**
+*	@brief The types of the classic move engine for \p Pieces_Quantity_T pieces on worlds of type \p World_T.
+*
+*	@details The default world has 8 bit cell ids, i.e. at most 256 cells. See LargeBoardEngineTypeSet for larger boards.
+*/
+template<class Pieces_Quantity_T, class World_T = tobor::v1_1::dynamic_rectangle_world<uint16_t, uint8_t>>
 struct ClassicEngineTypeSet {
 
-	using world_type = tobor::v1_1::dynamic_rectangle_world<uint16_t, uint8_t>;
+	using world_type = World_T;
 
 	using cell_id_type = tobor::v1_1::min_size_cell_id<world_type>;
 
@@ -36,4 +42,14 @@ struct ClassicEngineTypeSet {
 
 	using state_path_type_solver = tobor::v1_1::state_path<positions_of_pieces_type_solver>;
 
+	using compact_state_path_type_interactive = tobor::v1_1::compact_state_path<positions_of_pieces_type_interactive, move_engine_type>;
+
 };
+
+/**
+*	@brief The classic engine types for worlds with 16 bit cell ids, i.e. up to 65536 cells like 256 x 256 boards.
+*
+*	@details States take twice the memory of the default 8 bit cell ids, and the radix sort of explored levels needs one more pass per piece for boards with more than 256 cells.
+*/
+template<class Pieces_Quantity_T>
+using LargeBoardEngineTypeSet = ClassicEngineTypeSet<Pieces_Quantity_T, tobor::v1_1::dynamic_rectangle_world<uint32_t, uint16_t>>;
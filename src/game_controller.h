@@ -2,9 +2,19 @@
 
 #include "solver_environment.h"
 #include "abstract_game_controller.h"
+#include "board_registry.h"
+#include "thread_priority.h"
 
 #include <QString>
 
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+
 
 /**
 *	@brief Class for playing a game on a dynamic_rectangle_world, interactively and with solver.
@@ -22,6 +32,7 @@ public:
 	using world_type = typename engine_typeset::world_type;
 	using move_engine_type = typename engine_typeset::move_engine_type;
 	using state_path_type_interactive = typename engine_typeset::state_path_type_interactive;
+	using compact_state_path_type_interactive = typename engine_typeset::compact_state_path_type_interactive;
 	using move_path_type = typename engine_typeset::move_path_type;
 	using cell_id_type = typename engine_typeset::cell_id_type;
 	using positions_of_pieces_type_interactive = typename engine_typeset::positions_of_pieces_type_interactive;
@@ -39,26 +50,36 @@ public:
 	using solver_environment_type = SolverEnvironment<Pieces_Quantity_T>;
 
 	using solver_optimal_solutions_vector = typename solver_environment_type::optimal_solutions_vector;
+
+	using distance_exploration_type = typename solver_environment_type::distance_exploration_type;
+
+	using shared_board_type = SharedBoard<Pieces_Quantity_T>;
 private:
 
 	/* data */
 
-	world_type _world;
-
-	move_engine_type _move_engine;
+	/**
+	*	world and move engine, shared with all other controllers and factories using the same world.
+	*/
+	std::shared_ptr<const shared_board_type> _board;
 
 	/**
-	*	the path to current state in the game.
+	*	the path to current state in the game, as initial state and moves.
 	*/
-	state_path_type_interactive _path;
+	compact_state_path_type_interactive _path;
 
 	cell_id_type _target_cell;
 
 	std::optional<solver_environment_type> _solver;
 
+	/**
+	*	@brief Explorer of the last solver run, kept after stop_solver(). Solving again from its initial state continues from its explored levels.
+	*/
+	std::shared_ptr<distance_exploration_type> _distance_explorer;
+
 	/**
 	*	@brief Index of the first state where the solver moves to.
-	*	Or _solver_begin_index == _path.vector().size() in case of solver-initial state
+	*	Or _solver_begin_index == _path.size() in case of solver-initial state
 	*	
 	*	@details Must be zero whenever _solver.has_value() == false, for canonicity.
 	*/
@@ -73,6 +94,147 @@ private:
 
 	piece_id_type _selected_piece_id;
 
+	/**
+	*	@brief Solver run on _background_thread, shared by that thread and the controller.
+	*/
+	struct background_solve {
+		const positions_of_pieces_type_interactive initial_state;
+
+		std::mutex mutex;
+		std::condition_variable done_condition;
+
+		/** guarded by mutex */
+		bool done{ false };
+
+		/** guarded by mutex, empty if stopped or failed */
+		std::optional<solver_environment_type> solver;
+
+		background_solve(const positions_of_pieces_type_interactive& initial_state) : initial_state(initial_state) {}
+	};
+
+	std::shared_ptr<background_solve> _background_solve;
+
+	/**
+	*	@brief Runs run_background_solve() for _background_solve.
+	*/
+	std::jthread _background_thread;
+
+	/**
+	*	@brief Thread of a cancelled background solve together with its job.
+	*/
+	struct retired_background_thread {
+		std::shared_ptr<background_solve> job;
+		std::jthread thread;
+	};
+
+	/**
+	*	@brief Threads of cancelled background solves. They are asked to stop, but may still be extracting solutions.
+	*
+	*	@details Joined once their job is done, and on destruction, so that cancelling never waits for the GUI thread.
+	*	A std::list, because moving a joinable std::jthread onto another one joins that one.
+	*/
+	std::list<retired_background_thread> _retired_background_threads;
+
+	/**
+	*	@brief Explores level by level at reduced priority until a solution is found, everything is explored or a stop is requested on \p stop_token.
+	*
+	*	@details The stop is also checked inside each level, so a stopped thread ends soon unless it is already extracting solutions.
+	*/
+	static void run_background_solve(std::stop_token stop_token, std::shared_ptr<background_solve> job, std::shared_ptr<const shared_board_type> board, cell_id_type target_cell, std::function<void(const std::string&)> status_callback) {
+		lower_current_thread_priority();
+
+		std::optional<solver_environment_type> solver;
+		try {
+			const auto explorer{ std::make_shared<distance_exploration_type>(job->initial_state.naked()) };
+			explorer->set_stop_token(stop_token);
+
+			std::size_t max_depth{ 1 };
+			solver.emplace(explorer, job->initial_state, target_cell, board->move_engine(), status_callback, max_depth);
+			while (solver.value().status_code() == 1 && !stop_token.stop_requested()) {
+				solver.value().advance_max_depth(status_callback, ++max_depth);
+			}
+			if (solver.value().status_code() == 1) { // stopped before the end
+				solver.reset();
+			}
+			else {
+				explorer->set_stop_token(std::stop_token()); // the explorer outlives this thread when adopted
+			}
+		}
+		catch (...) {
+			solver.reset();
+		}
+		{
+			std::lock_guard<std::mutex> lock(job->mutex);
+			if (solver) job->solver.emplace(std::move(solver.value()));
+			job->done = true;
+		}
+		job->done_condition.notify_all();
+	}
+
+	/**
+	*	@brief Requests the background thread to stop and waits for it.
+	*/
+	void stop_background_thread() {
+		if (_background_thread.joinable()) {
+			_background_thread.request_stop();
+			_background_thread.join();
+		}
+	}
+
+	/**
+	*	@brief Joins the retired threads whose jobs are done, without waiting for the others.
+	*/
+	void join_finished_retired_threads() {
+		_retired_background_threads.remove_if([](const retired_background_thread& retired) {
+			std::lock_guard<std::mutex> lock(retired.job->mutex);
+			return retired.job->done; // the thread only returns after setting done
+		});
+	}
+
+	/**
+	*	@brief Requests the background thread of \p job to stop and moves it to _retired_background_threads, without waiting for it.
+	*/
+	void retire_background_thread(std::shared_ptr<background_solve> job) {
+		if (_background_thread.joinable()) {
+			_background_thread.request_stop();
+			_retired_background_threads.push_back(retired_background_thread{ std::move(job), std::move(_background_thread) });
+		}
+		join_finished_retired_threads();
+	}
+
+	/**
+	*	@brief Cancels the background solve unless it is finished, then its result is kept for adoption.
+	*
+	*	@details Does not wait for the background thread, which may be extracting solutions.
+	*/
+	void cancel_unfinished_background_solve() {
+		if (!_background_solve) return;
+		{
+			std::lock_guard<std::mutex> lock(_background_solve->mutex);
+			if (_background_solve->done) return;
+		}
+		retire_background_thread(std::move(_background_solve));
+	}
+
+	/**
+	*	@brief Removes the background solve and returns its result if it started from the current state, waiting for it if necessary.
+	*/
+	std::optional<solver_environment_type> take_background_solve(std::function<void(const std::string&)> status_callback) {
+		const std::shared_ptr<background_solve> job{ std::move(_background_solve) };
+		if (!job) return std::nullopt;
+		if (!(job->initial_state == current_state())) {
+			retire_background_thread(job);
+			return std::nullopt;
+		}
+		{
+			std::unique_lock<std::mutex> lock(job->mutex);
+			if (!job->done && status_callback) status_callback("Waiting for background solver...");
+			job->done_condition.wait(lock, [&]() { return job->done; });
+		}
+		stop_background_thread(); // already done, only joins
+		return std::move(job->solver);
+	}
+
 	/**
 	*	@brief Extracts coloring by applying a given permutation as std::integer_sequence and extracting SVGColorString
 	*/
@@ -91,18 +253,29 @@ private:
 public:
 
 	DRWGameController(
-		const world_type& world,
+		const std::shared_ptr<const shared_board_type>& board,
 		const positions_of_pieces_type_interactive& initial_state,
 		const cell_id_type& target_cell
 	) :
-		_world(world),
-		_move_engine(this->_world),
-		_path({ initial_state }),
+		_board(board),
+		_path(board->move_engine(), initial_state),
 		_target_cell(target_cell),
 		_solver(),
+		_distance_explorer(),
 		_solver_begin_index(0),
 		_solution_index(0),
-		_selected_piece_id(0)
+		_selected_piece_id(0),
+		_background_solve(),
+		_background_thread(),
+		_retired_background_threads()
+	{}
+
+	DRWGameController(
+		const world_type& world,
+		const positions_of_pieces_type_interactive& initial_state,
+		const cell_id_type& target_cell
+	) :
+		DRWGameController(BoardRegistry<Pieces_Quantity_T>::instance().get(world), initial_state, target_cell)
 	{}
 
 
@@ -112,33 +285,33 @@ public:
 	/**
 	*	@brief Returns the current state of the game.
 	*/
-	const positions_of_pieces_type_interactive& current_state() const { return _path.vector().back(); }
+	const positions_of_pieces_type_interactive& current_state() const { return _path.back(); }
 
 	/**
 	*	@brief Returns the state where the game was before the solver made any steps forward.
 	*	@brief Returns current_state() when not in solver mode.
 	*/
-	const positions_of_pieces_type_interactive& solver_begin_state() const {
+	positions_of_pieces_type_interactive solver_begin_state() const {
 		if (!_solver)
-			return _path.vector().back();
-		return _path.vector()[_solver_begin_index - 1];
+			return _path.back();
+		return _path[_solver_begin_index - 1];
 	}
 
 	virtual bool is_final() const override { return current_state().is_final(_target_cell); }
 
-	virtual bool is_initial() const override { return _path.vector().size() == 1; }
+	virtual bool is_initial() const override { return _path.size() == 1; }
 
 	/**
 	*	@brief Returns a const reference to underlying world.
 	*/
-	const world_type& world() const { return _world; }
+	const world_type& world() const { return _board->world(); }
 
 	/**
 	*	@brief Returns the target cell.
 	*/
 	const cell_id_type& target_cell() const { return _target_cell; }
 
-	virtual std::size_t depth() const override { return _path.vector().size() - 1; }
+	virtual std::size_t depth() const override { return _path.size() - 1; }
 
 	virtual std::size_t count_pieces() const override { return pieces_quantity_type::COUNT_ALL_PIECES; }
 
@@ -153,11 +326,14 @@ public:
 
 		if (is_final()) return 2;
 
-		auto next_state = _move_engine.successor_state_feedback(current_state(), piece_id, direction);
+		const piece_move_type applied_move(piece_id, direction);
+
+		auto next_state = _board->move_engine().successor_state_feedback(current_state(), piece_id, direction);
 
 		if (next_state == current_state()) return 1;
 
-		_path += next_state;
+		cancel_unfinished_background_solve();
+		_path.push_back(applied_move, next_state);
 
 		return 0;
 	}
@@ -171,11 +347,12 @@ public:
 
 		if (is_final()) return 2;
 
-		auto next_state = _move_engine.successor_state(current_state(), piece_id, direction);
+		auto next_state = _board->move_engine().successor_state(current_state(), piece_id, direction);
 
 		if (next_state == current_state()) return 1;
 
-		_path += next_state;
+		cancel_unfinished_background_solve();
+		_path.push_back(piece_move_type(piece_id, direction), next_state);
 
 		return 0;
 	}
@@ -188,16 +365,26 @@ public:
 	virtual void undo() override {
 		if (_solver) return; // or stop solver if undoing out of solver (?)
 
-		if (_path.vector().size() > 1) {
-			_path.vector().pop_back();
+		if (_path.size() > 1) {
+			_path.pop_back();
 		}
 	}
 
 	virtual uint8_t start_solver(std::function<void(const std::string&)> status_callback = nullptr) override {
 		if (_solver) return 2;
 
-		_solver.emplace(current_state(), _target_cell, _move_engine, status_callback);
-		_solver_begin_index = _path.vector().size();
+		auto background_solver{ take_background_solve(status_callback) };
+		if (background_solver) {
+			_solver.emplace(std::move(background_solver.value()));
+		}
+		else if (_distance_explorer && _distance_explorer->initial_state() == current_state().naked()) {
+			_solver.emplace(_distance_explorer, current_state(), _target_cell, _board->move_engine(), status_callback);
+		}
+		else {
+			_solver.emplace(current_state(), _target_cell, _board->move_engine(), status_callback);
+		}
+		_distance_explorer = _solver.value().distance_explorer();
+		_solver_begin_index = _path.size();
 
 		if (_solver.value().solutions_size() == 0) {
 			if (status_callback) status_callback("Solver terminated but did not find any solution.");
@@ -209,12 +396,20 @@ public:
 		return 0;
 	}
 
+	virtual void start_background_solver(std::function<void(const std::string&)> status_callback = nullptr) override {
+		if (_solver || _background_solve) return;
+
+		join_finished_retired_threads();
+		_background_solve = std::make_shared<background_solve>(current_state());
+		_background_thread = std::jthread(run_background_solve, _background_solve, _board, _target_cell, std::move(status_callback));
+	}
+
 	virtual void reset_solver_steps() override {
 		// go back to solver_begin_index
 
 		// could change this behavior into reset_steps(), resetting to initial state if not in solver mode. ###
 		if (!_solver) return;
-		_path.vector().erase(_path.vector().begin() + _solver_begin_index, _path.vector().end());
+		_path.truncate(_solver_begin_index);
 	}
 
 	virtual void stop_solver() override {
@@ -233,19 +428,17 @@ public:
 	virtual void move_by_solver(bool forward) override {
 		if (!_solver) return;
 
-		const auto index_next_move = _path.vector().size() - _solver_begin_index;
-
-		const auto index_next_state = index_next_move + 1;
+		const auto index_next_move = _path.size() - _solver_begin_index;
 
 		if (forward) {
 			if (is_final())
 				return;
-			_path += _solver.value().get_solution_state_path(_solution_index).vector()[index_next_state];
+			_path.push_back(_solver.value().get_compact_solution_state_path(_solution_index).move(index_next_move));
 		}
 		else { // back
 			if (index_next_move == 0) // already at solver start
 				return;
-			_path.vector().pop_back();
+			_path.pop_back();
 		}
 	}
 
@@ -256,8 +449,8 @@ public:
 	/**
 	*	@brief Returns the current path.
 	*/
-	state_path_type_interactive path() const noexcept {
-		return _path;
+	state_path_type_interactive path() const {
+		return _path.expand();
 	}
 
 	/**
@@ -267,7 +460,7 @@ public:
 		if (_solver) {
 			return _solver.value().optimal_solutions();
 		}
-		return solver_environment_type::optimal_solutions_vector();
+		return typename solver_environment_type::optimal_solutions_vector();
 	}
 
 	// remove the QStringList here! ###
@@ -332,6 +525,37 @@ public:
 		return example_svg_string;
 	}
 
+	virtual std::string svg_board(const tobor::v1_1::color_vector& current_color_vector) const override {
+		const auto target_color_id{ current_state().permutation()[0] }; // the target piece
+		return graphics_type::draw_tobor_board(
+			this->world(),
+			this->target_cell(),
+			current_color_vector.colors[target_color_id].getSVGColorString()
+		);
+	}
+
+	virtual std::string svg_piece(
+		const tobor::v1_1::color_vector& current_color_vector,
+		const std::size_t& color_id,
+		const tobor::v1_1::general_piece_shape_selection& shape
+	) const override {
+		return graphics_type::draw_piece(
+			this->world(),
+			current_color_vector.colors[color_id].getSVGColorString(),
+			shape
+		);
+	}
+
+	virtual std::pair<double, double> svg_piece_position(const std::size_t& color_id) const override {
+		const auto iter = std::find(
+			current_state().permutation().cbegin(),
+			current_state().permutation().cend(),
+			color_id
+		);
+		const auto piece_id{ static_cast<std::size_t>(iter - current_state().permutation().cbegin()) };
+		return graphics_type::cell_position(this->world(), current_state().naked().piece_positions()[piece_id]);
+	}
+
 	virtual uint8_t select_piece_by_piece_id(const std::size_t& piece_id) override {
 		if (_solver) return 2;
 		if (!(piece_id < pieces_quantity_type::COUNT_ALL_PIECES)) return 1;
@@ -361,7 +585,10 @@ public:
 		return current_state().permutation()[_selected_piece_id.value];
 	}
 
-	virtual ~DRWGameController() override {}
+	virtual ~DRWGameController() override {
+		stop_background_thread();
+		_retired_background_threads.clear(); // all were asked to stop, std::jthread joins on destruction
+	}
 
 	// todo: functions below:
 
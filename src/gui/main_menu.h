@@ -162,6 +162,8 @@ struct Menu_Main_Developer {
 	QAction* actionHighlightGeneratedTargetCells;
 	QAction* actionEnableAllMenuBarItems;
 	QAction* action22ReferenceGame;
+	QAction* actionDifficultyGame;
+	QAction* actionExportTrace;
 
 
 	Menu_Main_Developer(QMenuBar* menubar) {
@@ -181,9 +183,19 @@ struct Menu_Main_Developer {
 		action22ReferenceGame->setObjectName("action22ReferenceGame");
 		action22ReferenceGame->setEnabled(true);
 
+		actionDifficultyGame = new QAction(menuDeveloper);
+		actionDifficultyGame->setObjectName("actionDifficultyGame");
+		actionDifficultyGame->setEnabled(true);
+
+		actionExportTrace = new QAction(menuDeveloper);
+		actionExportTrace->setObjectName("actionExportTrace");
+		actionExportTrace->setEnabled(true);
+
 		menuDeveloper->addAction(actionHighlightGeneratedTargetCells);
 		menuDeveloper->addAction(actionEnableAllMenuBarItems);
 		menuDeveloper->addAction(action22ReferenceGame);
+		menuDeveloper->addAction(actionDifficultyGame);
+		menuDeveloper->addAction(actionExportTrace);
 	}
 };
 
@@ -2,8 +2,13 @@
 
 #include "cli.h"
 #include "debug_utils.h"
+#include "engine_benchmark.h"
 #include "logger.h"
 #include "mainwindow.h"
+#include "original_game_factory.h"
+#include "solver_daemon.h"
+#include "svg_benchmark.h"
+#include "trace.h"
 
 #include <QApplication>
 
@@ -55,6 +60,91 @@ namespace {
 		init_logger(config.log_console, config.log_file); // TODO pass custom log file path here.
 	}
 
+	int build_difficulty_index(const cli_config& config) {
+		using indexer_type = OriginalGameFactory<tobor::v1_1::pieces_quantity<uint8_t, 1, 3>>::difficulty_indexer_type;
+
+		spdlog::info("Building difficulty index from {} sampled games...", config.difficulty_index_samples);
+
+		try {
+			const std::size_t count_solved = indexer_type::build(
+				config.difficulty_index_path,
+				indexer_type::sampled_games(config.difficulty_index_samples, config.difficulty_index_seed),
+				config.difficulty_index_max_depth
+			);
+			spdlog::info("Wrote difficulty index with {} games to {}", count_solved, config.difficulty_index_path);
+		}
+		catch (const std::exception& e) {
+			spdlog::error("Failed to build difficulty index: {}", e.what());
+			return 1;
+		}
+		return 0;
+	}
+
+	int run_solver_daemon(const cli_config& config) {
+		const std::size_t count_threads{ config.serve_threads ? config.serve_threads : std::thread::hardware_concurrency() };
+
+		SolverDaemon daemon(count_threads);
+
+		try {
+			if (!config.serve_socket_path.empty()) {
+				spdlog::info("Solver daemon listening on {} with {} threads", config.serve_socket_path, count_threads);
+				daemon.serve_unix_socket(config.serve_socket_path);
+			}
+			else {
+				spdlog::info("Solver daemon reading from stdin with {} threads", count_threads);
+				daemon.serve(std::cin, std::cout);
+			}
+		}
+		catch (const std::exception& e) {
+			spdlog::error("Solver daemon failed: {}", e.what());
+			return 1;
+		}
+		return 0;
+	}
+
+	int run_engine_benchmark(const cli_config& config) {
+		using benchmark_type = EngineBenchmark<tobor::v1_1::pieces_quantity<uint8_t, 1, 3>>;
+
+		spdlog::info("Benchmarking engines on world {} with initial state {}, best of {} runs...", config.benchmark_world_counter, config.benchmark_state_counter, config.benchmark_repetitions);
+
+		for (const auto& r : benchmark_type::run(config.benchmark_world_counter, config.benchmark_state_counter, config.benchmark_repetitions)) {
+			spdlog::info(
+				"{}: optimal length {}, {} states of {} bytes, {} KiB explored, {:.3f} ms, {:.0f} states/s",
+				r.name, r.optimal_length, r.count_states, r.state_bytes, r.explored_bytes / 1024, r.seconds * 1000, r.states_per_second()
+			);
+		}
+		return 0;
+	}
+
+	int run_svg_benchmark(const cli_config& config) {
+		using benchmark_type = SvgBenchmark<tobor::v1_1::pieces_quantity<uint8_t, 1, 3>>;
+
+		spdlog::info("Benchmarking full-board SVG rendering on world {} with initial state {}, best of {} runs...", config.benchmark_world_counter, config.benchmark_state_counter, config.benchmark_repetitions);
+
+		for (const auto& r : benchmark_type::run(config.benchmark_world_counter, config.benchmark_state_counter, config.benchmark_repetitions)) {
+			spdlog::info(
+				"{}: {} bytes, {:.3f} ms per render, {:.0f} renders/s",
+				r.name, r.document_bytes, r.seconds_per_render * 1000, r.renders_per_second()
+			);
+		}
+		return 0;
+	}
+
+	void write_trace_file(const cli_config& config) {
+		if (config.trace_file_path.empty()) {
+			return;
+		}
+		if (!tobor::trace::enabled()) {
+			spdlog::warn("Trace points are not compiled in, see TOBOR_TRACE_ENABLE. Writing an empty trace to {}", config.trace_file_path);
+		}
+		if (tobor::trace::registry::instance().write_chrome_trace(config.trace_file_path)) {
+			spdlog::info("Wrote trace to {}", config.trace_file_path);
+		}
+		else {
+			spdlog::error("Failed to write trace to {}", config.trace_file_path);
+		}
+	}
+
 	int run_qt_app() {
 		// for some reason of destruction order, he logger must not be owned outside MainWindow:
 		auto ui_logger = spdlog::default_logger()->clone("ui");
@@ -93,7 +183,31 @@ int main(int argc, char* argv[]) {
 	config.log_file    = true;
 	// <- DEBUG
 
+	if (config.serve_stdio) {
+		config.log_console = false; // stdout carries the responses
+	}
+
 	interpret_cli_config(config);
 
-	run_qt_app();
+	int result{ 0 };
+
+	if (!config.difficulty_index_path.empty()) {
+		result = build_difficulty_index(config);
+	}
+	else if (config.serve_stdio || !config.serve_socket_path.empty()) {
+		result = run_solver_daemon(config);
+	}
+	else if (config.benchmark_engines) {
+		result = run_engine_benchmark(config);
+	}
+	else if (config.benchmark_svg) {
+		result = run_svg_benchmark(config);
+	}
+	else {
+		run_qt_app();
+	}
+
+	write_trace_file(config);
+
+	return result;
 }
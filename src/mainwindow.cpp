@@ -9,14 +9,18 @@
 #include "gui/license_dialog.h"
 #include "ui_mainwindow.h"
 
+#include "difficulty_game_factory.h"
 #include "original_game_factory.h"
 #include "special_case_22_game_factory.h"
+#include "trace.h"
 
 #include "spdlog/sinks/qt_sinks.h"
 #include "spdlog/spdlog.h"
 
 #include <QDebug>
+#include <QFileDialog>
 #include <QGraphicsSvgItem>
+#include <QInputDialog>
 #include <QMessageBox>
 #include <QStringListModel>
 #include <QStyle>
@@ -98,6 +102,8 @@ void MainWindow::setTextAndShortcutsForMainMenu() {
 	menubar_root.rootMenu->developer.actionHighlightGeneratedTargetCells->setText(QCoreApplication::translate("MainWindow", "&Highlight generated target cells", nullptr));
 	menubar_root.rootMenu->developer.actionEnableAllMenuBarItems->setText(QCoreApplication::translate("MainWindow", "&Enable all MenuBar items", nullptr));
 	menubar_root.rootMenu->developer.action22ReferenceGame->setText(QCoreApplication::translate("MainWindow", "&Start 22 Reference Game", nullptr));
+	menubar_root.rootMenu->developer.actionDifficultyGame->setText(QCoreApplication::translate("MainWindow", "Start Game by &Difficulty...", nullptr));
+	menubar_root.rootMenu->developer.actionExportTrace->setText(QCoreApplication::translate("MainWindow", "Export &Trace...", nullptr));
 
 	/// VIEW
 
@@ -212,6 +218,50 @@ void MainWindow::startSolver()
 	refreshAll();
 }
 
+void MainWindow::startDifficultyGame()
+{
+	if (current_game) return showErrorActionAvailable();
+
+	const QString path = QFileDialog::getOpenFileName(this, "Open Difficulty Index", QString(), "Difficulty Index (*.tdi);;All Files (*)");
+	if (path.isEmpty()) return;
+
+	bool ok{ false };
+	const int requested_length = QInputDialog::getInt(this, "Start Game by Difficulty", "Optimal number of moves:", 10, 0, 64, 1, &ok);
+	if (!ok) return;
+
+	using factory_type = DifficultyGameFactory<tobor::v1_1::pieces_quantity<uint8_t, 1, 3>>;
+
+	try {
+		auto index = std::make_shared<const DifficultyIndex>(path.toStdString());
+
+		std::uniform_int_distribution<std::size_t> distribution_on_position(0, index->count_games());
+
+		auto fac = factory_type(index, static_cast<std::size_t>(requested_length), distribution_on_position(generator));
+
+		logger->info("Starting a game with optimal solution length " + std::to_string(fac.optimal_length()) + ".");
+
+		factory_history.emplace_back(fac.clone());
+
+		startGame(&fac);
+	}
+	catch (const std::exception& e) {
+		return showErrorDialog(e.what());
+	}
+}
+
+void MainWindow::exportTrace()
+{
+	if (!tobor::trace::enabled()) return showErrorDialog("Trace points are not compiled in. Rebuild with TOBOR_TRACE_ENABLE defined.");
+
+	const QString path = QFileDialog::getSaveFileName(this, "Export Trace", "tobor_trace.json", "Chrome Trace (*.json);;All Files (*)");
+	if (path.isEmpty()) return;
+
+	if (!tobor::trace::registry::instance().write_chrome_trace(path.toStdString())) {
+		return showErrorDialog("Failed to write trace to " + path);
+	}
+	logger->info("Exported trace to " + path.toStdString());
+}
+
 void MainWindow::stopSolver()
 {
 	if (!current_game) return showErrorDialog("Cannot stop solver with no game opened.");
@@ -236,6 +286,7 @@ void MainWindow::startGame(AbstractGameFactory* factory)
 	if (current_game) return showErrorActionAvailable();
 
 	current_game.reset(factory->create());
+	current_game->start_background_solver();
 	current_color_vector = tobor::v1_0::color_vector::get_standard_coloring(static_cast<uint8_t>(current_game->count_pieces())); // standard coloring without permutation
 
 	createColorActions();
@@ -412,6 +463,61 @@ void MainWindow::viewSvgInMainView(const QString& svg_string)
 	svgViewToolchain = std::move(new_chain); // then destroy old objects in reverse order compared to construction...
 }
 
+void MainWindow::viewGameInMainView(tobor::v1_1::general_piece_shape_selection shape)
+{
+	std::vector<std::string> colors;
+	for (const auto& color : current_color_vector.colors) {
+		colors.push_back(color.getSVGColorString());
+	}
+
+	if (!svgViewToolchain.showsLayersOf(current_game, shape, colors)) {
+		SvgViewToolchain new_chain;
+
+		const auto board_svg_string{ QString::fromStdString(current_game->svg_board(current_color_vector)) };
+		QXmlStreamReader xml;
+		xml.addData(board_svg_string);
+		new_chain.q_svg_renderer = std::make_unique<QSvgRenderer>(&xml);
+
+		auto board_item = new QGraphicsSvgItem();
+		board_item->setSharedRenderer(new_chain.q_svg_renderer.get()); // does not take ownership
+		board_item->setCacheMode(QGraphicsItem::DeviceCoordinateCache); // board is only rasterized again when view is scaled
+
+		new_chain.q_graphics_scene = std::make_unique<QGraphicsScene>();
+		new_chain.q_graphics_scene->addItem(board_item); // takes ownership
+		new_chain.q_graphics_scene->setSceneRect(board_item->boundingRect());
+
+		for (std::size_t color_id{ 0 }; color_id < current_game->count_pieces(); ++color_id) {
+			const auto piece_svg_string{ QString::fromStdString(current_game->svg_piece(current_color_vector, color_id, shape)) };
+			QXmlStreamReader piece_xml;
+			piece_xml.addData(piece_svg_string);
+			new_chain.q_piece_svg_renderers.push_back(std::make_unique<QSvgRenderer>(&piece_xml));
+
+			auto piece_item = new QGraphicsSvgItem();
+			piece_item->setSharedRenderer(new_chain.q_piece_svg_renderers.back().get()); // does not take ownership
+			piece_item->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+			piece_item->setZValue(1); // in front of board
+
+			new_chain.q_graphics_scene->addItem(piece_item); // takes ownership
+			new_chain.q_piece_items.push_back(piece_item);
+		}
+
+		new_chain.game = current_game;
+		new_chain.shape = shape;
+		new_chain.colors = std::move(colors);
+
+		ui->graphicsView->setScene(new_chain.q_graphics_scene.get()); // does not take ownership
+		ui->graphicsView->fitInView(new_chain.q_graphics_scene.get()->sceneRect(), Qt::KeepAspectRatio);
+		ui->graphicsView->show();
+
+		svgViewToolchain = std::move(new_chain); // then destroy old objects in reverse order compared to construction...
+	}
+
+	for (std::size_t color_id{ 0 }; color_id < svgViewToolchain.q_piece_items.size(); ++color_id) {
+		const auto [x, y] = current_game->svg_piece_position(color_id);
+		svgViewToolchain.q_piece_items[color_id]->setPos(x, y);
+	}
+}
+
 void MainWindow::on_actionNewGame_triggered() {
 	startGame();
 }
@@ -565,9 +671,7 @@ void MainWindow::refreshSVG()
 			shape = tobor::v1_1::general_piece_shape_selection::DUCK;
 		}
 
-		auto svg_as_string = current_game->svg(current_color_vector, shape);
-
-		viewSvgInMainView(svg_as_string);
+		viewGameInMainView(shape);
 	}
 	else {
 		QGraphicsScene* scene = new QGraphicsScene();
@@ -774,6 +878,16 @@ void MainWindow::on_action22ReferenceGame_triggered()
 	startReferenceGame22();
 }
 
+void MainWindow::on_actionDifficultyGame_triggered()
+{
+	startDifficultyGame();
+}
+
+void MainWindow::on_actionExportTrace_triggered()
+{
+	exportTrace();
+}
+
 void MainWindow::ShapeSelectionItems::createInsideQMenu(MainWindow* mainWindow, QMenu* qMenu) {
 	(void)mainWindow;
 
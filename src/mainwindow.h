@@ -21,6 +21,8 @@
 
 #include <memory>
 #include <random>
+#include <string>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -34,18 +36,41 @@ class MainWindow : public QMainWindow {
 public:
 	struct SvgViewToolchain {
 		std::unique_ptr<QSvgRenderer>   q_svg_renderer;
+		std::vector<std::unique_ptr<QSvgRenderer>> q_piece_svg_renderers; // one per color id, empty if not showing a game in layers
 		std::unique_ptr<QGraphicsScene> q_graphics_scene;
+
+		std::vector<QGraphicsSvgItem*> q_piece_items; // owned by q_graphics_scene, one per color id
+
+		// game, shape and piece colors the layers have been drawn for:
+		std::weak_ptr<AbstractGameController> game;
+		tobor::v1_1::general_piece_shape_selection shape{ tobor::v1_1::general_piece_shape_selection::BALL };
+		std::vector<std::string> colors;
+
 		/*
 		 */
 		inline SvgViewToolchain& operator=(SvgViewToolchain&& another) noexcept {
-			q_graphics_scene = std::move(another.q_graphics_scene);
-			q_svg_renderer   = std::move(another.q_svg_renderer);
+			q_graphics_scene      = std::move(another.q_graphics_scene);
+			q_piece_svg_renderers = std::move(another.q_piece_svg_renderers);
+			q_svg_renderer        = std::move(another.q_svg_renderer);
+
+			q_piece_items = std::move(another.q_piece_items);
+			game          = std::move(another.game);
+			shape         = another.shape;
+			colors        = std::move(another.colors);
 
 			return *this;
 		}
 
+		/**
+		 *	@brief Returns true if and only if the layers can be reused to show \p game by only moving its pieces.
+		 */
+		inline bool showsLayersOf(const std::shared_ptr<AbstractGameController>& game_p, tobor::v1_1::general_piece_shape_selection shape_p, const std::vector<std::string>& colors_p) const {
+			return game.lock() == game_p && shape == shape_p && colors == colors_p;
+		}
+
 		inline ~SvgViewToolchain() {
 			q_graphics_scene.reset();
+			q_piece_svg_renderers.clear();
 			q_svg_renderer.reset();
 		}
 	};
@@ -104,8 +129,12 @@ private Q_SLOTS:
 
 private:
 	void startReferenceGame22();
+	void startDifficultyGame();
 	void stopGame();
 
+	// developer
+	void exportTrace();
+
 	// solver
 	void startSolver();
 	void selectSolution(std::size_t index);
@@ -121,6 +150,8 @@ private Q_SLOTS:
 	void on_actionHighlightGeneratedTargetCells_triggered();
 	void on_actionEnableAllMenuBarItems_triggered();
 	void on_action22ReferenceGame_triggered();
+	void on_actionDifficultyGame_triggered();
+	void on_actionExportTrace_triggered();
 	void on_actionAbout_triggered();
 	void on_actionNewGame_triggered();
 	void on_actionStopGame_triggered();
@@ -181,6 +212,13 @@ private:
 
 	inline void viewSvgInMainView(const std::string& svg_string) { return viewSvgInMainView(QString::fromStdString(svg_string)); }
 
+	/**
+	 *	@brief Shows current_game as a static board layer with one item per piece on top.
+	 *
+	 *	@details Layers are drawn once per game, shape and coloring. Afterwards only the piece items are moved.
+	 */
+	void viewGameInMainView(tobor::v1_1::general_piece_shape_selection shape);
+
 	void disconnectInputConnections() {
 		for (QMetaObject::Connection& c : inputConnections) {
 			QObject::disconnect(c);
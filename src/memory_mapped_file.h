@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+/**
+*	@brief Read-only memory mapping of an entire file, RAII owned.
+*
+*	@details Throws std::runtime_error if the file cannot be opened or mapped. Empty files are mapped to data() == nullptr.
+*/
+class MemoryMappedFile {
+
+	const std::byte* _data{ nullptr };
+
+	std::size_t _size{ 0 };
+
+#ifdef _WIN32
+	HANDLE _file{ INVALID_HANDLE_VALUE };
+	HANDLE _mapping{ nullptr };
+#endif
+
+	void release() noexcept {
+#ifdef _WIN32
+		if (_data) UnmapViewOfFile(_data);
+		if (_mapping) CloseHandle(_mapping);
+		if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+		_mapping = nullptr;
+		_file = INVALID_HANDLE_VALUE;
+#else
+		if (_data) munmap(const_cast<std::byte*>(_data), _size);
+#endif
+		_data = nullptr;
+		_size = 0;
+	}
+
+public:
+
+	MemoryMappedFile() {}
+
+	explicit MemoryMappedFile(const std::string& path) {
+#ifdef _WIN32
+		_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (_file == INVALID_HANDLE_VALUE) {
+			throw std::runtime_error("Cannot open file " + path);
+		}
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(_file, &size)) {
+			release();
+			throw std::runtime_error("Cannot determine size of file " + path);
+		}
+		_size = static_cast<std::size_t>(size.QuadPart);
+		if (_size == 0) {
+			return;
+		}
+		_mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!_mapping) {
+			release();
+			throw std::runtime_error("Cannot map file " + path);
+		}
+		_data = static_cast<const std::byte*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+		if (!_data) {
+			release();
+			throw std::runtime_error("Cannot map file " + path);
+		}
+#else
+		const int descriptor{ ::open(path.c_str(), O_RDONLY) };
+		if (descriptor < 0) {
+			throw std::runtime_error("Cannot open file " + path);
+		}
+		struct stat status;
+		if (::fstat(descriptor, &status) != 0) {
+			::close(descriptor);
+			throw std::runtime_error("Cannot determine size of file " + path);
+		}
+		const std::size_t size{ static_cast<std::size_t>(status.st_size) };
+		if (size != 0) {
+			void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0);
+			if (mapped == MAP_FAILED) {
+				::close(descriptor);
+				throw std::runtime_error("Cannot map file " + path);
+			}
+			_data = static_cast<const std::byte*>(mapped);
+			_size = size;
+		}
+		::close(descriptor); // the mapping stays valid
+#endif
+	}
+
+	MemoryMappedFile(const MemoryMappedFile&) = delete;
+
+	MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+	MemoryMappedFile(MemoryMappedFile&& another) noexcept { *this = std::move(another); }
+
+	MemoryMappedFile& operator=(MemoryMappedFile&& another) noexcept {
+		if (this != &another) {
+			release();
+			std::swap(_data, another._data);
+			std::swap(_size, another._size);
+#ifdef _WIN32
+			std::swap(_file, another._file);
+			std::swap(_mapping, another._mapping);
+#endif
+		}
+		return *this;
+	}
+
+	~MemoryMappedFile() { release(); }
+
+	inline const std::byte* data() const noexcept { return _data; }
+
+	inline std::size_t size() const noexcept { return _size; }
+
+};
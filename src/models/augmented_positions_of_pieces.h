@@ -49,7 +49,12 @@ namespace tobor {
 
 			using all_pieces_array_type = std::array<cell_id_type, COUNT_ALL_PIECES>;
 
-			using permutation_type = std::array<std::size_t, COUNT_ALL_PIECES>;
+			/**
+			*	@brief Maps piece ids of the current, sorted order to the piece ids of the initial order, i.e. to colors.
+			*
+			*	@details Stored as pieces_quantity_type::int_type, the same type as piece ids, to keep interactive states small.
+			*/
+			using permutation_type = std::array<piece_id_int_type, COUNT_ALL_PIECES>;
 
 			using naked_type = positions_of_pieces<pieces_quantity_type, cell_id_type, SORTED_TARGET_PIECES, SORTED_NON_TARGET_PIECES>;
 
@@ -65,14 +70,17 @@ namespace tobor {
 			permutation_type _permutation;
 
 			inline static void reset_perm(permutation_type& perm) {
-				for (std::size_t i = 0; i < COUNT_ALL_PIECES; ++i)
+				for (piece_id_int_type i = 0; i < COUNT_ALL_PIECES; ++i)
 					perm[i] = i;
 			}
 
+			/**
+			*	@brief Reorders \p target such that its element i becomes the former element \p p [i]. \p target must be a std::array of size COUNT_ALL_PIECES.
+			*/
 			template<class Aggregation_Type1, class Aggregation_Type2>
 			inline static void apply_perm(const Aggregation_Type1& p, Aggregation_Type2& target) {
-				auto update = Aggregation_Type2(target);
-				for (std::size_t i{ 0 }; i < p.size(); ++i) {
+				Aggregation_Type2 update;
+				for (std::size_t i{ 0 }; i < COUNT_ALL_PIECES; ++i) {
 					update[i] = target[p[i]];
 				}
 				target = update;
@@ -131,6 +139,23 @@ namespace tobor {
 				return _piece_positions == another._piece_positions;
 			}
 
+			inline static uint64_t zobrist_update(const uint64_t& hash, const bool& is_target_piece, const cell_id_type& from, const cell_id_type& to) noexcept {
+				return naked_type::zobrist_update(hash, is_target_piece, from, to);
+			}
+
+			/**
+			*	@brief Returns the same Zobrist hash as naked().zobrist_hash(). The permutation is not taken into account.
+			*/
+			inline uint64_t zobrist_hash() const noexcept {
+				uint64_t hash{ 0 };
+				for (piece_id_int_type i{ 0 }; i < COUNT_ALL_PIECES; ++i) {
+					hash ^= naked_type::zobrist_key(_piece_positions[i], i < COUNT_TARGET_PIECES);
+				}
+				return hash;
+			}
+
+			inline std::size_t hash() const noexcept { return static_cast<std::size_t>(zobrist_hash()); }
+
 			inline typename std::array<cell_id_type, COUNT_ALL_PIECES>::const_iterator target_pieces_cbegin() const {
 				return _piece_positions.cbegin();
 			};
@@ -191,12 +216,12 @@ namespace tobor {
 					reset_perm(p_new);
 					if constexpr (SORTED_TARGET_PIECES && !(COUNT_TARGET_PIECES <= 1)) {
 						//std::sort(target_pieces_begin(), target_pieces_end());
-						std::sort(p_new.begin(), p_new.begin() + COUNT_TARGET_PIECES, [&](const std::size_t& l, const std::size_t& r) {
+						std::sort(p_new.begin(), p_new.begin() + COUNT_TARGET_PIECES, [&](const piece_id_int_type& l, const piece_id_int_type& r) {
 							return _piece_positions[l] < _piece_positions[r];
 							});
 					}
 					if constexpr (SORTED_NON_TARGET_PIECES && !(COUNT_NON_TARGET_PIECES <= 1)) {
-						std::sort(p_new.begin() + COUNT_TARGET_PIECES, p_new.begin() + COUNT_ALL_PIECES, [&](const std::size_t& l, const std::size_t& r) {
+						std::sort(p_new.begin() + COUNT_TARGET_PIECES, p_new.begin() + COUNT_ALL_PIECES, [&](const piece_id_int_type& l, const piece_id_int_type& r) {
 							return _piece_positions[l] < _piece_positions[r];
 							});
 					}
@@ -291,6 +316,13 @@ namespace tobor {
 }
 
 namespace std {
+	template <class Pieces_Quantity_T, class Cell_Id_Type, bool SORTED_TARGET_PIECES_V, bool SORTED_NON_TARGET_PIECES_V>
+	struct hash<tobor::v1_1::augmented_positions_of_pieces<Pieces_Quantity_T, Cell_Id_Type, SORTED_TARGET_PIECES_V, SORTED_NON_TARGET_PIECES_V>> {
+		inline std::size_t operator()(const tobor::v1_1::augmented_positions_of_pieces<Pieces_Quantity_T, Cell_Id_Type, SORTED_TARGET_PIECES_V, SORTED_NON_TARGET_PIECES_V>& state) const noexcept {
+			return state.hash();
+		}
+	};
+
 	template <class Pieces_Quantity_T, class Cell_Id_Type, bool SORTED_TARGET_PIECES_V, bool SORTED_NON_TARGET_PIECES_V>
 	inline void swap(
 		tobor::v1_1::augmented_positions_of_pieces<Pieces_Quantity_T, Cell_Id_Type, SORTED_TARGET_PIECES_V, SORTED_NON_TARGET_PIECES_V>& a,
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "direction.h"
+#include "state_path.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tobor {
+	namespace v1_1 {
+
+		/**
+		*	@brief Represents a path by its initial state and its moves, each move packed into one byte.
+		*
+		*	@details Every \p CHECKPOINT_INTERVAL_V -th state and the last state are stored explicitly. Any other state is materialized on access,
+		*	replaying at most \p CHECKPOINT_INTERVAL_V - 1 moves from the preceding checkpoint with the move engine.
+		*	The move engine must outlive the path.
+		*/
+		template<class Position_Of_Pieces_T, class Move_Engine_T, std::size_t CHECKPOINT_INTERVAL_V = 16>
+		class compact_state_path {
+		public:
+
+			using positions_of_pieces_type = Position_Of_Pieces_T;
+
+			using move_engine_type = Move_Engine_T;
+
+			using piece_move_type = typename move_engine_type::piece_move_type;
+
+			using piece_id_type = typename piece_move_type::piece_id_type;
+
+			using pieces_quantity_type = typename piece_move_type::pieces_quantity_type;
+
+			using direction_type = tobor::v1_0::direction;
+
+			using state_path_type = state_path<positions_of_pieces_type>;
+
+			using encoded_move_type = uint8_t;
+
+			static constexpr std::size_t CHECKPOINT_INTERVAL{ CHECKPOINT_INTERVAL_V };
+
+			static_assert(CHECKPOINT_INTERVAL > 0, "compact_state_path: CHECKPOINT_INTERVAL must be positive");
+
+			static_assert(pieces_quantity_type::COUNT_ALL_PIECES <= 64, "compact_state_path: piece ids do not fit into 6 bits");
+
+		private:
+
+			const move_engine_type* _engine;
+
+			/**
+			*	@brief States with index 0, CHECKPOINT_INTERVAL, 2 * CHECKPOINT_INTERVAL, ... as far as contained in the path.
+			*/
+			std::vector<positions_of_pieces_type> _checkpoints;
+
+			/**
+			*	@brief The moves, _moves[i] leads from state i to state i + 1.
+			*/
+			std::vector<encoded_move_type> _moves;
+
+			positions_of_pieces_type _back;
+
+		public:
+
+			/**
+			*	@brief Encodes \p move as piece id in the upper 6 bits and direction bit index in the lower 2 bits.
+			*/
+			inline static encoded_move_type encode(const piece_move_type& move) {
+				return static_cast<encoded_move_type>((move.pid.value << 2) | std::countr_zero(move.dir.get()));
+			}
+
+			inline static piece_move_type decode(const encoded_move_type& byte) {
+				direction_type dir{ direction_type::begin() };
+				for (encoded_move_type i{ 0 }; i < (byte & 0b11); ++i) {
+					++dir;
+				}
+				return piece_move_type(piece_id_type(static_cast<typename piece_id_type::int_type>(byte >> 2)), dir);
+			}
+
+			compact_state_path(const move_engine_type& engine, const positions_of_pieces_type& initial_state) :
+				_engine(&engine),
+				_checkpoints{ initial_state },
+				_moves(),
+				_back(initial_state)
+			{}
+
+			/**
+			*	@brief Compresses \p path, which must not be empty and must not contain two equal successive states.
+			*/
+			compact_state_path(const move_engine_type& engine, const state_path_type& path) :
+				compact_state_path(engine, path.vector().front())
+			{
+				_moves.reserve(path.vector().size() - 1);
+				for (std::size_t i{ 1 }; i < path.vector().size(); ++i) {
+					push_back(engine.state_minus_state(path.vector()[i], path.vector()[i - 1]), path.vector()[i]);
+				}
+			}
+
+			/**
+			*	@brief Returns the number of states, which is the number of moves plus one.
+			*/
+			inline std::size_t size() const noexcept { return _moves.size() + 1; }
+
+			inline const positions_of_pieces_type& front() const noexcept { return _checkpoints.front(); }
+
+			inline const positions_of_pieces_type& back() const noexcept { return _back; }
+
+			/**
+			*	@brief Returns the move leading from state \p index to state \p index + 1.
+			*/
+			inline piece_move_type move(std::size_t index) const { return decode(_moves[index]); }
+
+			/**
+			*	@brief Returns the state with index \p index, materializing it from the preceding checkpoint.
+			*/
+			positions_of_pieces_type operator[](std::size_t index) const {
+				if (index + 1 == size()) {
+					return _back;
+				}
+				positions_of_pieces_type state{ _checkpoints[index / CHECKPOINT_INTERVAL] };
+				for (std::size_t i{ index - index % CHECKPOINT_INTERVAL }; i < index; ++i) {
+					state = _engine->successor_state(state, decode(_moves[i]));
+				}
+				return state;
+			}
+
+			/**
+			*	@brief Appends the state reached from back() by \p move, given as \p successor.
+			*/
+			inline void push_back(const piece_move_type& move, const positions_of_pieces_type& successor) {
+				_moves.push_back(encode(move));
+				if (_moves.size() % CHECKPOINT_INTERVAL == 0) {
+					_checkpoints.push_back(successor);
+				}
+				_back = successor;
+			}
+
+			/**
+			*	@brief Appends the state reached from back() by \p move.
+			*/
+			inline void push_back(const piece_move_type& move) {
+				push_back(move, _engine->successor_state(_back, move));
+			}
+
+			/**
+			*	@brief Removes the last state. The path must contain at least two states.
+			*/
+			inline void pop_back() {
+				truncate(size() - 1);
+			}
+
+			/**
+			*	@brief Removes all states with index \p count or greater. \p count must be positive.
+			*/
+			inline void truncate(std::size_t count) {
+				if (count >= size()) {
+					return;
+				}
+				_back = (*this)[count - 1];
+				_moves.resize(count - 1);
+				_checkpoints.erase(_checkpoints.begin() + ((count - 1) / CHECKPOINT_INTERVAL + 1), _checkpoints.end());
+			}
+
+			/**
+			*	@brief Materializes all states.
+			*/
+			state_path_type expand() const {
+				typename state_path_type::vector_type states;
+				states.reserve(size());
+				states.push_back(front());
+				for (const auto& byte : _moves) {
+					states.push_back(_engine->successor_state(states.back(), decode(byte)));
+				}
+				return state_path_type(states);
+			}
+		};
+
+	}
+}
@@ -5,6 +5,7 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include <cstdint>
 
 namespace tobor {
 	namespace v1_1 {
@@ -22,7 +23,9 @@ namespace tobor {
 			using int_size_type = Int_Size_Type_T;
 			using int_cell_id_type = Int_Cell_Id_Type_T;
 
-			using wall_vector_type = wall_vector;
+			using wall_vector_type = wall_bitset;
+			using wall_reference = wall_bitset::reference;
+			using wall_mask_type = wall_bitset::word_type;
 			using type = dynamic_rectangle_world;
 
 		private:
@@ -159,35 +162,35 @@ namespace tobor {
 
 			/* wall accessors **************************************************************************************/
 
-			inline wall& south_wall_by_transposed_id(int_cell_id_type transposed_id) noexcept {
+			inline wall_reference south_wall_by_transposed_id(int_cell_id_type transposed_id) noexcept {
 				return h_walls[transposed_id];
 			}
 
-			inline const wall& south_wall_by_transposed_id(int_cell_id_type transposed_id) const noexcept {
+			inline bool south_wall_by_transposed_id(int_cell_id_type transposed_id) const noexcept {
 				return h_walls[transposed_id];
 			}
 
-			inline wall& north_wall_by_transposed_id(int_cell_id_type transposed_id) noexcept {
+			inline wall_reference north_wall_by_transposed_id(int_cell_id_type transposed_id) noexcept {
 				return h_walls[wide(transposed_id) + 1];
 			}
 
-			inline const wall& north_wall_by_transposed_id(int_cell_id_type transposed_id) const noexcept {
+			inline bool north_wall_by_transposed_id(int_cell_id_type transposed_id) const noexcept {
 				return h_walls[wide(transposed_id) + 1];
 			}
 
-			inline wall& west_wall_by_id(int_cell_id_type id) noexcept {
+			inline wall_reference west_wall_by_id(int_cell_id_type id) noexcept {
 				return v_walls[id];
 			}
 
-			inline const wall& west_wall_by_id(int_cell_id_type id) const noexcept {
+			inline bool west_wall_by_id(int_cell_id_type id) const noexcept {
 				return v_walls[id];
 			}
 
-			inline wall& east_wall_by_id(int_cell_id_type id) noexcept {
+			inline wall_reference east_wall_by_id(int_cell_id_type id) noexcept {
 				return v_walls[wide(id) + 1];
 			}
 
-			inline const wall& east_wall_by_id(int_cell_id_type id) const noexcept {
+			inline bool east_wall_by_id(int_cell_id_type id) const noexcept {
 				return v_walls[wide(id) + 1];
 			}
 
@@ -234,6 +237,50 @@ namespace tobor {
 				return y_size;
 			}
 
+			/**
+			*	@brief Returns true if and only if both worlds have the same size and the same walls.
+			*/
+			inline bool operator==(const dynamic_rectangle_world& another) const noexcept {
+				return x_size == another.x_size && y_size == another.y_size && h_walls == another.h_walls && v_walls == another.v_walls;
+			}
+
+			/**
+			*	@brief Returns a hash value of size and walls. Equal worlds have equal hash values.
+			*
+			*	@details The value only depends on the world's content, not on platform or program run. It may be persisted.
+			*/
+			inline uint64_t wall_hash() const noexcept {
+				auto mix = [](uint64_t z) { // splitmix64 finalizer
+					z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+					z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+					return z ^ (z >> 31);
+					};
+				uint64_t hash{ mix((static_cast<uint64_t>(x_size) << 32) ^ static_cast<uint64_t>(y_size)) };
+				for (const auto word : h_walls.words()) {
+					hash = mix(hash ^ word);
+				}
+				for (const auto word : v_walls.words()) {
+					hash = mix(hash ^ word);
+				}
+				return hash;
+			}
+
+			/**
+			*	@brief Returns the vertical walls of row \p y_coord. Bit x is the west wall of cell (x, \p y_coord), bit x + 1 its east wall.
+			*	@details Requires get_horizontal_size() < 64.
+			*/
+			inline wall_mask_type row_wall_mask(int_cell_id_type y_coord) const noexcept {
+				return v_walls.extract(static_cast<std::size_t>(x_size) * y_coord, static_cast<std::size_t>(x_size) + 1);
+			}
+
+			/**
+			*	@brief Returns the horizontal walls of column \p x_coord. Bit y is the south wall of cell (\p x_coord, y), bit y + 1 its north wall.
+			*	@details Requires get_vertical_size() < 64.
+			*/
+			inline wall_mask_type column_wall_mask(int_cell_id_type x_coord) const noexcept {
+				return h_walls.extract(static_cast<std::size_t>(y_size) * x_coord, static_cast<std::size_t>(y_size) + 1);
+			}
+
 			type turn_left_90() const { // only for quadratic
 				if (x_size != y_size) {
 					throw std::logic_error("Cannot turn for non-quadratic board.");
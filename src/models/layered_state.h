@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+
+namespace tobor {
+	namespace v1_1 {
+
+		/**
+		*	@brief A state together with its index on a path, so that a graph of paths of fixed length can contain the same state at several positions.
+		*
+		*	@details Ordered by state first, so that for paths where each state occurs at one position only, the order equals the order of the states.
+		*/
+		template<class Positions_Of_Pieces_T>
+		struct layered_state {
+
+			using positions_of_pieces_type = Positions_Of_Pieces_T;
+
+			std::size_t layer;
+
+			positions_of_pieces_type state;
+
+			layered_state(std::size_t layer, const positions_of_pieces_type& state) : layer(layer), state(state) {}
+
+			inline bool operator<(const layered_state& another) const noexcept {
+				return state == another.state ? layer < another.layer : state < another.state;
+			}
+
+			inline bool operator==(const layered_state& another) const noexcept {
+				return layer == another.layer && state == another.state;
+			}
+
+			inline bool operator!=(const layered_state& another) const noexcept {
+				return !(*this == another);
+			}
+
+			/**
+			*	@brief Returns the number of pieces in which both states differ.
+			*/
+			inline std::size_t count_changed_pieces(const layered_state& another) const {
+				return state.count_changed_pieces(another.state);
+			}
+		};
+
+	}
+}
@@ -4,9 +4,13 @@
 #include "state_path.h"
 #include "augmented_positions_of_pieces.h"
 
-#include <vector>
-#include <set>
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iterator>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 
 namespace tobor {
@@ -31,6 +35,10 @@ namespace tobor {
 		private:
 			vector_type _move_vector;
 
+			struct hash_functor {
+				inline std::size_t operator()(const move_path& path) const noexcept { return path.hash(); }
+			};
+
 		public:
 
 			move_path() {}
@@ -171,6 +179,74 @@ namespace tobor {
 				return false;
 			}
 
+			/**
+			*	@brief Returns a hash value of the move sequence.
+			*/
+			inline std::size_t hash() const noexcept {
+				std::size_t result{ static_cast<std::size_t>(14695981039346656037ull) };
+				for (const piece_move_type& move : _move_vector) {
+					result ^= (static_cast<std::size_t>(move.pid.value) << 8) | static_cast<std::size_t>(move.dir.get());
+					result *= static_cast<std::size_t>(1099511628211ull);
+				}
+				return result;
+			}
+
+			/**
+			*	@brief Returns the Foata normal form of this path, seen as a trace where moves of different pieces commute.
+			*
+			*	@details The k-th step consists of the k-th move of each piece moving at least k times, ordered by piece id.
+			*	Two paths have the same normal form if and only if they are equal up to swapping adjacent moves of different pieces.
+			*	Runs in O(L * N) for L moves and N pieces.
+			*/
+			inline move_path foata_normal_form() const {
+				static constexpr std::size_t COUNT_ALL_PIECES{ pieces_quantity_type::COUNT_ALL_PIECES };
+
+				std::array<std::size_t, COUNT_ALL_PIECES> cursors; // per piece: index of its next move not yet taken
+				cursors.fill(0);
+
+				move_path result;
+				result._move_vector.reserve(_move_vector.size());
+
+				while (result._move_vector.size() < _move_vector.size()) { // one step per iteration
+					for (std::size_t pid{ 0 }; pid < COUNT_ALL_PIECES; ++pid) {
+						std::size_t& cursor{ cursors[pid] };
+						while (cursor < _move_vector.size() && _move_vector[cursor].pid.value != pid) {
+							++cursor;
+						}
+						if (cursor < _move_vector.size()) {
+							result._move_vector.push_back(_move_vector[cursor]);
+							++cursor;
+						}
+					}
+				}
+
+				return result;
+			}
+
+			/**
+			*	@brief Partitions \p paths into classes of equal foata_normal_form().
+			*
+			*	@details Classes are ordered by their first occurrence in \p paths.
+			*	In contrast to interleaving_partitioning_improved(), two paths are put together even if the intermediate interleavings are not contained in \p paths,
+			*	and moves of the same piece are never swapped.
+			*/
+			inline static std::vector<std::vector<move_path>> interleaving_partitioning_by_normal_form(const std::vector<move_path>& paths) {
+				std::vector<std::vector<move_path>> equivalence_classes;
+
+				std::unordered_map<move_path, std::size_t, hash_functor> class_index_by_normal_form;
+				class_index_by_normal_form.reserve(paths.size());
+
+				for (const move_path& path : paths) {
+					const auto [iter, inserted] = class_index_by_normal_form.try_emplace(path.foata_normal_form(), equivalence_classes.size());
+					if (inserted) {
+						equivalence_classes.emplace_back();
+					}
+					equivalence_classes[iter->second].push_back(path);
+				}
+
+				return equivalence_classes;
+			}
+
 			inline static std::vector<std::vector<move_path>> interleaving_partitioning_improved(const std::vector<move_path>& paths) {
 				std::vector<std::vector<move_path>> equivalence_classes;
 
@@ -259,6 +335,11 @@ namespace tobor {
 				return equivalence_classes;
 			}
 
+			/**
+			*	@brief Partitions \p paths into classes connected by swapping adjacent unequal moves, including moves of the same piece, where each intermediate path is contained in \p paths.
+			*
+			*	@details For a classification where moves of different pieces always commute, see interleaving_partitioning_by_normal_form().
+			*/
 			inline static std::vector<std::vector<move_path>> interleaving_partitioning(const std::vector<move_path>& paths) {
 
 				static constexpr bool USE_IMPROVEMENT{ true };
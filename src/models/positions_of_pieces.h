@@ -2,7 +2,12 @@
 
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
 #include <algorithm>
 
 
@@ -56,121 +61,82 @@ namespace tobor {
 			all_pieces_array_type _piece_positions;
 
 
-			template <class T>
-			using bucket = std::array<std::vector<T>, 256>; // ### make 256 template in future version.
-
-			template<class T>
-			class bucket_iterator {
-
-				typename bucket<T>::iterator _outer_iter;
-				const typename bucket<T>::iterator _outer_iter_end;
-				typename bucket<T>::value_type::iterator _inner_iter;
-
-				inline void advance_until_valid() {
-					if (_outer_iter == _outer_iter_end)
-						return;
-
-					while (_inner_iter == _outer_iter->end()) {
-						++_outer_iter;
-						if (_outer_iter == _outer_iter_end) {
-							return; // reached end iterator
-						}
-						// jump to beginning of next bucket:
-						_inner_iter = _outer_iter->begin();
-					}
-				}
-
-				bucket_iterator(const typename bucket<T>::iterator& outer_iter, const typename bucket<T>::iterator& outer_iter_end, const typename bucket<T>::value_type::iterator& inner_iter) : _outer_iter(outer_iter), _outer_iter_end(outer_iter_end), _inner_iter(inner_iter) {
-					advance_until_valid();
-				}
-
-			public:
-
-				inline static bucket_iterator begin_of(bucket<T>& b) {
-					return bucket_iterator(b.begin(), b.end(), b[0].begin());
-				}
-
-				inline static bucket_iterator end_of(bucket<T>& b) {
-					return bucket_iterator(b.end(), b.end(), b[0].begin());
-				}
+		public:
 
-				inline T& operator*() {
-					return *_inner_iter;
-				}
 
-				inline bucket_iterator operator++() {
-					// guaranteed that this is no end iterator.
-					// guaranteed that inner is no end iterator;
-					++_inner_iter;
-					advance_until_valid();
-					return *this;
-				}
+			/**
+			*	@brief Sorts the range [\p first, \p last) and removes duplicates, writing the result to the front of the range.
+			*
+			*	@details Least significant digit radix sort, one counting sort pass per byte of cell id, alternating between the range and one buffer of the same size.
+			*	@return Returns the end of the sorted unique states. The elements from there to \p last are left in a valid but unspecified state.
+			*/
+			template<class Iterator_T>
+			inline static Iterator_T range_sort_unique(Iterator_T first, Iterator_T last) {
+				using int_cell_id_type = typename cell_id_type::int_cell_id_type;
 
-				inline bool is_end() const {
-					return _outer_iter == _outer_iter_end;
-				}
+				const std::size_t count{ static_cast<std::size_t>(std::distance(first, last)) };
 
-				inline bool operator==(const bucket_iterator another) {
-					return (_outer_iter == another._outer_iter) && (
-						is_end() || another.is_end() || _inner_iter == another._inner_iter
-						);
+				if (count < 2) {
+					return last;
 				}
 
-			};
-
-			template<class Iterator_T>
-			inline static void sort_in_buckets(std::array<std::vector<positions_of_pieces>, 256>& buckets, const Iterator_T& begin, const Iterator_T& end, const std::function<uint8_t(const positions_of_pieces&)>& get_bucket) {
-
-				for (auto iter = begin; iter != end; ++iter) {
-					const uint8_t value = get_bucket(*iter);
-					if (buckets[value].empty() || !(buckets[value].back() == *iter)) {
-						buckets[value].push_back(*iter);
+				// bytes above the lowest one which are zero in all cell ids, e.g. the high byte of 16 bit ids on boards with up to 256 cells, do not need a pass:
+				int_cell_id_type used_bits{ 0 };
+				for (auto iter = first; iter != last; ++iter) {
+					for (const auto& cell : iter->_piece_positions) {
+						used_bits |= cell.get_id();
 					}
 				}
-			}
-
-		public:
 
-
-			template<class Collection_T>
-			inline static void collection_sort_unique(Collection_T& c) {
-				using int_cell_id_type = typename cell_id_type::int_cell_id_type;
-
-				bucket<positions_of_pieces> old_buckets;
-				bucket<positions_of_pieces> new_buckets;
-
-				for (auto iter = std::cbegin(c); iter != std::cend(c); ++iter) {
-					old_buckets[0].push_back(*iter);
-				}
-				c.clear();
+				std::vector<positions_of_pieces> buffer(count, *first);
+				bool sorted_into_buffer{ false };
 
 				for (std::size_t i{ 0 }; i < COUNT_ALL_PIECES; ++i) {
 					for (std::size_t j{ 0 }; j < sizeof(int_cell_id_type); ++j) {
 
-						for (auto& element : new_buckets) {
-							element.clear();
+						if (j > 0 && ((static_cast<uint64_t>(used_bits) >> (j * 8)) & 0xFF) == 0) {
+							continue;
 						}
 
-						std::function<uint8_t(const positions_of_pieces&)> f = [&](const positions_of_pieces& p) -> uint8_t {
+						const auto digit = [&](const positions_of_pieces& p) -> uint8_t {
 							const int_cell_id_type raw_id = p._piece_positions[static_cast<pieces_quantity_int_type>(COUNT_ALL_PIECES - i - 1)].get_id();
 							return (raw_id >> (j * 8)) & 0xFF;
 							};
 
-						sort_in_buckets(new_buckets, bucket_iterator<positions_of_pieces>::begin_of(old_buckets), bucket_iterator<positions_of_pieces>::end_of(old_buckets), f);
-
-						std::swap(old_buckets, new_buckets);
+						const auto counting_sort_pass = [&](auto source_first, auto source_last, auto destination_first) {
+							std::array<std::size_t, 256> offsets{};
+							for (auto iter = source_first; iter != source_last; ++iter) {
+								++offsets[digit(*iter)];
+							}
+							std::size_t sum{ 0 };
+							for (auto& offset : offsets) {
+								sum += std::exchange(offset, sum);
+							}
+							for (auto iter = source_first; iter != source_last; ++iter) {
+								*(destination_first + offsets[digit(*iter)]++) = *iter;
+							}
+							};
 
+						if (sorted_into_buffer) {
+							counting_sort_pass(buffer.cbegin(), buffer.cend(), first);
+						}
+						else {
+							counting_sort_pass(first, last, buffer.begin());
+						}
+						sorted_into_buffer = !sorted_into_buffer;
 					}
 				}
 
-				for (auto iter = bucket_iterator<positions_of_pieces>::begin_of(old_buckets); iter != bucket_iterator<positions_of_pieces>::end_of(old_buckets); ++iter) {
-					c.push_back(*iter);
+				if (sorted_into_buffer) {
+					std::copy(buffer.cbegin(), buffer.cend(), first);
 				}
 
-				// check is sorted here
-
-				return;
+				return std::unique(first, last);
+			}
 
+			template<class Collection_T>
+			inline static void collection_sort_unique(Collection_T& c) {
+				c.erase(range_sort_unique(std::begin(c), std::end(c)), std::end(c));
 			}
 
 			template<class Iter>
@@ -213,6 +179,40 @@ namespace tobor {
 				return _piece_positions == another._piece_positions;
 			}
 
+			/**
+			*	@brief Returns the Zobrist key of a piece located at \p cell, with different keys for target and non-target pieces.
+			*
+			*	@details Keys are pseudo-random, derived from the raw cell id by the splitmix64 finalizer. They do not depend on platform or program run.
+			*/
+			inline static uint64_t zobrist_key(const cell_id_type& cell, const bool& is_target_piece) noexcept {
+				uint64_t z{ (static_cast<uint64_t>(cell.get_id()) << 1 | static_cast<uint64_t>(is_target_piece)) + 0x9e3779b97f4a7c15ull };
+				z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+				z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+				return z ^ (z >> 31);
+			}
+
+			/**
+			*	@brief Returns \p hash updated for a piece moved from \p from to \p to.
+			*/
+			inline static uint64_t zobrist_update(const uint64_t& hash, const bool& is_target_piece, const cell_id_type& from, const cell_id_type& to) noexcept {
+				return hash ^ zobrist_key(from, is_target_piece) ^ zobrist_key(to, is_target_piece);
+			}
+
+			/**
+			*	@brief Returns the xor of the zobrist_key() of all pieces.
+			*
+			*	@details Independent of the order of pieces inside the target and non-target sections, so sorted and unsorted layouts of the same pieces hash equally.
+			*/
+			inline uint64_t zobrist_hash() const noexcept {
+				uint64_t hash{ 0 };
+				for (pieces_quantity_int_type i{ 0 }; i < COUNT_ALL_PIECES; ++i) {
+					hash ^= zobrist_key(_piece_positions[i], i < COUNT_TARGET_PIECES);
+				}
+				return hash;
+			}
+
+			inline std::size_t hash() const noexcept { return static_cast<std::size_t>(zobrist_hash()); }
+
 			inline typename std::array<cell_id_type, COUNT_ALL_PIECES>::const_iterator target_pieces_cbegin() const {
 				return _piece_positions.cbegin();
 			};
@@ -343,6 +343,13 @@ namespace tobor {
 
 namespace std {
 
+	template <class Pieces_Quantity_Type, class Cell_Id_Type_T, bool SORTED_TARGET_PIECES_V, bool SORTED_NON_TARGET_PIECES_V>
+	struct hash<tobor::v1_0::positions_of_pieces<Pieces_Quantity_Type, Cell_Id_Type_T, SORTED_TARGET_PIECES_V, SORTED_NON_TARGET_PIECES_V>> {
+		inline std::size_t operator()(const tobor::v1_0::positions_of_pieces<Pieces_Quantity_Type, Cell_Id_Type_T, SORTED_TARGET_PIECES_V, SORTED_NON_TARGET_PIECES_V>& state) const noexcept {
+			return state.hash();
+		}
+	};
+
 	template <class Pieces_Quantity_Type, class Cell_Id_Type_T, bool SORTED_TARGET_PIECES_V, bool SORTED_NON_TARGET_PIECES_V>
 	inline void swap(
 		tobor::v1_0::positions_of_pieces<Pieces_Quantity_Type, Cell_Id_Type_T, SORTED_TARGET_PIECES_V, SORTED_NON_TARGET_PIECES_V>& a,
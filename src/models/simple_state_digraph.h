@@ -1,8 +1,11 @@
 #pragma once
 
 
-#include <set>
+#include <cstddef>
 #include <map>
+#include <memory_resource>
+#include <set>
+#include <utility>
 
 namespace tobor {
 	namespace v1_1 {
@@ -15,20 +18,47 @@ namespace tobor {
 		public:
 
 			using state_type = State_T;
-			using state_set_type = std::set<state_type>;
+			using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+			using state_set_type = std::pmr::set<state_type>;
 			using state_label_type = void;
 
+			/**
+			*	@brief Links of a node. Allocator-aware, so that nodes inserted into the map allocate their links from the map's memory resource.
+			*/
 			struct node_links {
-				std::set<state_type> predecessors;
-				std::set<state_type> successors;
+				using allocator_type = simple_state_digraph::allocator_type;
+
+				state_set_type predecessors;
+				state_set_type successors;
+
+				node_links(const allocator_type& alloc = {}) : predecessors(alloc), successors(alloc) {}
+
+				node_links(const node_links&) = default;
+
+				node_links(node_links&&) = default;
+
+				node_links(const node_links& another, const allocator_type& alloc) : predecessors(another.predecessors, alloc), successors(another.successors, alloc) {}
+
+				node_links(node_links&& another, const allocator_type& alloc) : predecessors(std::move(another.predecessors), alloc), successors(std::move(another.successors), alloc) {}
+
+				node_links& operator=(const node_links&) = default;
+
+				node_links& operator=(node_links&&) = default;
 			};
 
-			using map_type = std::map<state_type, node_links>;
+			using map_type = std::pmr::map<state_type, node_links>;
 			using map_iterator_type = typename map_type::iterator;
 			using map_const_iterator_type = typename map_type::const_iterator;
 
 			map_type map;
 
+			simple_state_digraph() {}
+
+			/**
+			*	@brief Constructs an empty graph whose nodes and links are all allocated from \p resource, which must outlive the graph.
+			*/
+			explicit simple_state_digraph(std::pmr::memory_resource* resource) : map(resource) {}
+
 			inline void clear() {
 				return map.clear();
 			}
@@ -38,21 +68,48 @@ namespace tobor {
 		class simple_state_digraph {
 		public:
 			using state_type = State_T;
-			using state_set_type = std::set<state_type>;
+			using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+			using state_set_type = std::pmr::set<state_type>;
 			using state_label_type = State_Label_T;
 
+			/**
+			*	@brief Links and labels of a node. Allocator-aware, so that nodes inserted into the map allocate their links from the map's memory resource.
+			*/
 			struct node_links {
+				using allocator_type = simple_state_digraph::allocator_type;
+
 				state_set_type predecessors;
 				state_set_type successors;
 				state_label_type labels;
+
+				node_links(const allocator_type& alloc = {}) : predecessors(alloc), successors(alloc), labels() {}
+
+				node_links(const node_links&) = default;
+
+				node_links(node_links&&) = default;
+
+				node_links(const node_links& another, const allocator_type& alloc) : predecessors(another.predecessors, alloc), successors(another.successors, alloc), labels(another.labels) {}
+
+				node_links(node_links&& another, const allocator_type& alloc) : predecessors(std::move(another.predecessors), alloc), successors(std::move(another.successors), alloc), labels(std::move(another.labels)) {}
+
+				node_links& operator=(const node_links&) = default;
+
+				node_links& operator=(node_links&&) = default;
 			};
 
-			using map_type = std::map<state_type, node_links>;
+			using map_type = std::pmr::map<state_type, node_links>;
 			using map_iterator_type = typename map_type::iterator;
 			using map_const_iterator_type = typename map_type::const_iterator;
 
 			map_type map;
 
+			simple_state_digraph() {}
+
+			/**
+			*	@brief Constructs an empty graph whose nodes and links are all allocated from \p resource, which must outlive the graph.
+			*/
+			explicit simple_state_digraph(std::pmr::memory_resource* resource) : map(resource) {}
+
 			inline void clear() {
 				return map.clear();
 			}
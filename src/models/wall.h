@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace tobor {
@@ -30,5 +32,115 @@ namespace tobor {
 	namespace v1_1 {
 		using wall = tobor::v1_0::wall;
 		using wall_vector = std::vector<wall>;
+
+		/**
+		*	@brief Bit-packed sequence of walls, 64 walls per word.
+		*
+		*	@details Bits beyond size() are always zero. Therefore words can be compared and hashed directly.
+		*/
+		class wall_bitset {
+		public:
+
+			using word_type = uint64_t;
+			using size_type = std::size_t;
+
+			static constexpr size_type WORD_BITS{ 64 };
+
+			/**
+			*	@brief Proxy to a single wall, to be used like a bool&.
+			*/
+			class reference {
+
+				friend class wall_bitset;
+
+				word_type& _word;
+				word_type _mask;
+
+				reference(word_type& word, word_type mask) noexcept : _word(word), _mask(mask) {}
+
+			public:
+
+				reference(const reference&) = default;
+
+				inline operator bool() const noexcept { return _word & _mask; }
+
+				inline reference& operator=(bool value) noexcept {
+					if (value) {
+						_word |= _mask;
+					}
+					else {
+						_word &= ~_mask;
+					}
+					return *this;
+				}
+
+				inline reference& operator=(const reference& another) noexcept { return *this = static_cast<bool>(another); }
+
+				inline reference& operator|=(bool value) noexcept {
+					if (value) {
+						_word |= _mask;
+					}
+					return *this;
+				}
+			};
+
+		private:
+
+			std::vector<word_type> _words;
+
+			size_type _size;
+
+		public:
+
+			wall_bitset() : _words(), _size(0) {}
+
+			wall_bitset(size_type size, bool value) :
+				_words((size + WORD_BITS - 1) / WORD_BITS, value ? ~word_type(0) : word_type(0)),
+				_size(size)
+			{
+				if (value && size % WORD_BITS) {
+					_words.back() &= (word_type(1) << (size % WORD_BITS)) - 1;
+				}
+			}
+
+			inline size_type size() const noexcept { return _size; }
+
+			inline const std::vector<word_type>& words() const noexcept { return _words; }
+
+			inline reference operator[](size_type index) noexcept {
+				return reference(_words[index / WORD_BITS], word_type(1) << (index % WORD_BITS));
+			}
+
+			inline bool operator[](size_type index) const noexcept {
+				return (_words[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+			}
+
+			/**
+			*	@brief Returns the walls at [ \p begin, \p begin + \p count ) as the lowest bits of a word, the wall at \p begin being the least significant bit.
+			*	@details Requires \p count <= WORD_BITS. Walls beyond size() are returned as zero.
+			*/
+			inline word_type extract(size_type begin, size_type count) const noexcept {
+				if (count == 0 || begin >= _size) {
+					return 0;
+				}
+				const size_type word_index{ begin / WORD_BITS };
+				const size_type offset{ begin % WORD_BITS };
+
+				word_type result{ _words[word_index] >> offset };
+				if (offset != 0 && word_index + 1 < _words.size()) {
+					result |= _words[word_index + 1] << (WORD_BITS - offset);
+				}
+				if (count < WORD_BITS) {
+					result &= (word_type(1) << count) - 1;
+				}
+				return result;
+			}
+
+			inline bool operator==(const wall_bitset& another) const noexcept {
+				return _size == another._size && _words == another._words;
+			}
+
+			inline bool operator!=(const wall_bitset& another) const noexcept { return !(*this == another); }
+		};
 	}
 }
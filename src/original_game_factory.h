@@ -1,11 +1,14 @@
 #pragma once
 
 #include "game_controller.h"
+#include "board_registry.h"
+#include "difficulty_index.h"
 #include "world_generator_1_1.h"
 #include "cyclic_group_game_factory.h"
 
 #include <string>
 #include <memory>
+#include <utility>
 
 /**
 *	@brief Factory to create original games with 16x16 cells.
@@ -32,13 +35,42 @@ public:
 
 	using product_generator_type = tobor::v1_1::world_generator::product_group_generator<board_generator_type, state_generator_type>;
 
+	using shared_board_type = SharedBoard<pieces_quantity_type>;
+
+	using difficulty_indexer_type = DifficultyIndexer<pieces_quantity_type, board_generator_type, state_generator_type>;
+
 private:
 
 	product_generator_type _product_generator;
 
+	/**
+	*	@brief Board of the last call to board(), kept alive for reuse by the next call.
+	*/
+	mutable std::shared_ptr<const shared_board_type> _board;
+
+	/**
+	*	@brief (select_aligned_world, rotation) of the world generator belonging to _board.
+	*/
+	mutable std::pair<uint64_t, uint64_t> _board_key;
+
+	/**
+	*	@brief Returns the shared board for the current world generator counter.
+	*/
+	std::shared_ptr<const shared_board_type> board() const {
+		const auto [select_aligned_world, rotation, select_target] = _product_generator.main().split_element();
+		(void)select_target;
+		const auto key{ std::make_pair(select_aligned_world, rotation) };
+
+		if (!_board || _board_key != key) {
+			_board = BoardRegistry<pieces_quantity_type>::instance().get(_product_generator.main().get_tobor_world());
+			_board_key = key;
+		}
+		return _board;
+	}
+
 public:
 
-	OriginalGameFactory() : _product_generator() {}
+	OriginalGameFactory() : _product_generator(), _board(), _board_key() {}
 
 	OriginalGameFactory(const OriginalGameFactory& another) = default;
 
@@ -47,7 +79,9 @@ public:
 
 	[[nodiscard]] virtual AbstractGameController* create() const override {
 
-		auto world = _product_generator.main().get_tobor_world();
+		const auto shared_board{ board() };
+
+		const auto& world{ shared_board->world() };
 
 		std::vector<typename pieces_quantity_type::int_type> initial_color_permutation;
 
@@ -63,9 +97,9 @@ public:
 		}
 
 		return new DRWGameController<pieces_quantity_type>(
-			world,
+			shared_board,
 			_product_generator.side().get_positions_of_pieces(world).apply_permutation(initial_color_permutation),
-			_product_generator.main().get_target_cell()
+			_product_generator.main().get_target_cell(shared_board->target_cells())
 		);
 	}
 
@@ -107,17 +141,11 @@ public:
 
 		using graphics = tobor::v1_1::tobor_graphics<world_type, positions_of_pieces_type_interactive>;
 
-		const auto world{ _product_generator.main().get_tobor_world() };
+		const auto shared_board{ board() };
 
-		auto raw_cell_id_vector = board_generator_type::get_target_cell_id_vector(world);
+		const auto& world{ shared_board->world() };
 
-		std::vector<cell_id_type> comfort_cell_id_vector;
-
-		std::transform(raw_cell_id_vector.cbegin(), raw_cell_id_vector.cend(), std::back_inserter(comfort_cell_id_vector),
-			[&](const auto& raw_cell_id) {
-				return cell_id_type::create_by_id(raw_cell_id, world);
-			}
-		);
+		const std::vector<cell_id_type>& comfort_cell_id_vector{ shared_board->target_cells() };
 
 		std::string svg_string = graphics::draw_tobor_world_with_cell_markers(
 			world,
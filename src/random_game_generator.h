@@ -0,0 +1,199 @@
+#pragma once
+
+#include "board_registry.h"
+#include "world_generator_1_1.h"
+
+#include "engine/distance_exploration.h"
+#include "engine/parallel_algorithms.h"
+#include "engine/path_classificator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+/**
+*	@brief Generates random games on random worlds, keeping only those whose optimal solution length and number of solution classes meet given requirements.
+*
+*	@details Rejection sampling: candidates are generated and solved in parallel batches.
+*	The solver stops exploring a candidate as soon as it exceeds the maximum optimal length.
+*	Each candidate is generated from its own seed derived from the global seed and its index, so results do not depend on thread scheduling.
+*/
+template<class Pieces_Quantity_T>
+class RandomGameGenerator {
+public:
+
+	using pieces_quantity_type = Pieces_Quantity_T;
+
+	using engine_typeset = ClassicEngineTypeSet<pieces_quantity_type>;
+
+	using world_type = typename engine_typeset::world_type;
+
+	using cell_id_type = typename engine_typeset::cell_id_type;
+
+	using positions_of_pieces_type_solver = typename engine_typeset::positions_of_pieces_type_solver;
+
+	using positions_of_pieces_type_interactive = typename engine_typeset::positions_of_pieces_type_interactive;
+
+	using distance_exploration_type = tobor::v1_1::distance_exploration<typename engine_typeset::move_engine_type, positions_of_pieces_type_solver>;
+
+	using path_classificator_type = tobor::v1_1::path_classificator<positions_of_pieces_type_solver>;
+
+	using bigraph_type = tobor::v1_1::simple_state_digraph<positions_of_pieces_type_solver, std::vector<bool>>;
+
+	using world_generator_type = tobor::v1_1::world_generator::random_world_generator;
+
+	using shared_board_type = SharedBoard<pieces_quantity_type>;
+
+	static_assert(std::is_same_v<world_type, world_generator_type::world_type>, "RandomGameGenerator: world types of engine and world generator differ");
+
+	/**
+	*	@brief Bounds for the games to accept, all inclusive.
+	*/
+	struct requirements {
+		std::size_t min_optimal_length{ 1 };
+		std::size_t max_optimal_length{ 20 };
+		std::size_t min_solution_classes{ 1 };
+		std::size_t max_solution_classes{ std::numeric_limits<std::size_t>::max() };
+	};
+
+	/**
+	*	@brief A generated game together with its solver results.
+	*/
+	struct game {
+		world_type world;
+		positions_of_pieces_type_interactive initial_state;
+		cell_id_type target_cell;
+		std::size_t optimal_length;
+		std::size_t count_solution_classes;
+	};
+
+private:
+
+	world_generator_type _world_generator;
+
+	inline static uint64_t candidate_seed(const uint64_t& seed, const uint64_t& index) {
+		// splitmix64 finalizer, to decorrelate seeds of neighbouring indices
+		uint64_t z{ seed + (index + 1) * 0x9E37'79B9'7F4A'7C15 };
+		z = (z ^ (z >> 30)) * 0xBF58'476D'1CE4'E5B9;
+		z = (z ^ (z >> 27)) * 0x94D0'49BB'1331'11EB;
+		return z ^ (z >> 31);
+	}
+
+	/**
+	*	@brief Places all pieces on distinct random non-blocked cells of \p world.
+	*/
+	template<class Random_Engine_T>
+	static positions_of_pieces_type_interactive random_initial_state(const world_type& world, Random_Engine_T& engine) {
+		std::uniform_int_distribution<typename cell_id_type::int_size_type> cell_distribution(0, world.count_cells() - 1);
+
+		std::vector<typename cell_id_type::int_cell_id_type> selected;
+		selected.reserve(pieces_quantity_type::COUNT_ALL_PIECES);
+		while (selected.size() < pieces_quantity_type::COUNT_ALL_PIECES) {
+			const auto id{ static_cast<typename cell_id_type::int_cell_id_type>(cell_distribution(engine)) };
+			if (world.blocked(id) || std::find(selected.cbegin(), selected.cend(), id) != selected.cend())
+				continue;
+			selected.push_back(id);
+		}
+
+		typename positions_of_pieces_type_interactive::target_pieces_array_type target_pieces;
+		typename positions_of_pieces_type_interactive::non_target_pieces_array_type non_target_pieces;
+		for (std::size_t i{ 0 }; i < pieces_quantity_type::COUNT_TARGET_PIECES; ++i) {
+			target_pieces[i] = cell_id_type::create_by_id(selected[i], world);
+		}
+		for (std::size_t i{ 0 }; i < pieces_quantity_type::COUNT_NON_TARGET_PIECES; ++i) {
+			non_target_pieces[i] = cell_id_type::create_by_id(selected[pieces_quantity_type::COUNT_TARGET_PIECES + i], world);
+		}
+		return positions_of_pieces_type_interactive(target_pieces, non_target_pieces);
+	}
+
+public:
+
+	RandomGameGenerator(const world_generator_type& world_generator = world_generator_type()) : _world_generator(world_generator) {}
+
+	/**
+	*	@brief Generates the candidate game with index \p index for \p seed, and solves it.
+	*
+	*	@return Returns the game if it meets \p req, otherwise std::nullopt.
+	*/
+	std::optional<game> candidate(const uint64_t& seed, const uint64_t& index, const requirements& req) const {
+		std::mt19937_64 engine(candidate_seed(seed, index));
+
+		const shared_board_type board(_world_generator(engine));
+		const auto& world{ board.world() };
+
+		std::uniform_int_distribution<std::size_t> target_distribution(0, board.target_cells().size() - 1);
+		const cell_id_type target_cell{ board.target_cells()[target_distribution(engine)] };
+
+		const positions_of_pieces_type_interactive initial_state{ random_initial_state(world, engine) };
+
+		distance_exploration_type explorer(positions_of_pieces_type_solver(initial_state.naked()));
+
+		const std::size_t optimal_length{ explorer.explore_until_target(board.move_engine(), target_cell, req.max_optimal_length) };
+
+		if (optimal_length == distance_exploration_type::SIZE_TYPE_MAX || optimal_length < req.min_optimal_length || optimal_length > req.max_optimal_length) {
+			return std::nullopt;
+		}
+
+		std::pmr::monotonic_buffer_resource arena;
+		bigraph_type bigraph(&arena);
+		explorer.get_simple_bigraph(board.move_engine(), target_cell, bigraph);
+		const std::size_t count_solution_classes{ path_classificator_type::make_state_graph_path_partitioning(bigraph) };
+
+		if (count_solution_classes < req.min_solution_classes || count_solution_classes > req.max_solution_classes) {
+			return std::nullopt;
+		}
+
+		return game{ world, initial_state, target_cell, optimal_length, count_solution_classes };
+	}
+
+	/**
+	*	@brief Generates up to \p count games meeting \p req, trying at most \p max_candidates candidates in batches of \p batch_size solved in parallel.
+	*
+	*	@details Games are accepted in the order of candidate indices, so the result only depends on \p seed, not on \p batch_size or thread scheduling. It contains less than \p count games only if \p max_candidates were exhausted.
+	*/
+	std::vector<game> generate(
+		const std::size_t& count,
+		const requirements& req,
+		const uint64_t& seed,
+		const std::size_t& batch_size = 64,
+		const uint64_t& max_candidates = 1 << 20
+	) const {
+		std::vector<game> accepted;
+		accepted.reserve(count);
+
+		std::vector<uint64_t> indices;
+		std::vector<std::optional<game>> results;
+
+		uint64_t next_index{ 0 };
+
+		while (accepted.size() < count && next_index < max_candidates) {
+			const std::size_t current_batch_size{ static_cast<std::size_t>(std::min<uint64_t>(std::max<std::size_t>(batch_size, 1), max_candidates - next_index)) };
+
+			indices.resize(current_batch_size);
+			std::iota(indices.begin(), indices.end(), next_index);
+			next_index += current_batch_size;
+
+			results.clear();
+			results.resize(current_batch_size);
+
+			tobor::v1_1::parallel::transform(indices.cbegin(), indices.cend(), results.begin(), [&](const uint64_t& index) {
+				return candidate(seed, index, req);
+				});
+
+			for (auto& result : results) {
+				if (result && accepted.size() < count) {
+					accepted.push_back(std::move(*result));
+				}
+			}
+		}
+
+		return accepted;
+	}
+
+};
@@ -0,0 +1,584 @@
+#pragma once
+
+#include "board_registry.h"
+#include "board_rotation.h"
+#include "solver_environment.h"
+#include "thread_pool.h"
+#include "world_generator_1_1.h"
+
+#include "models/pieces_quantity.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+	#include <sys/socket.h>
+	#include <sys/un.h>
+	#include <unistd.h>
+#endif
+
+/**
+*	@brief Solves games with a fixed quantity of pieces for the SolverDaemon.
+*
+*	@details Keeps the distance explorers of the most recently solved initial states, together with their boards,
+*	so that requests for known states (e.g. other target cells) continue from the explored levels.
+*	The least recently used explorers are evicted as soon as all cached explorers together hold more states than fit into the cache budget.
+*	Games are solved in their canonical rotation, see BoardRotation, so that all four rotations of a game share one cache entry.
+*	Thread-safe, requests for the same initial state are serialized.
+*/
+template<class Pieces_Quantity_T>
+class SolverSession {
+public:
+
+	using pieces_quantity_type = Pieces_Quantity_T;
+
+	using engine_typeset = ClassicEngineTypeSet<pieces_quantity_type>;
+
+	using world_type = typename engine_typeset::world_type;
+
+	using cell_id_type = typename engine_typeset::cell_id_type;
+
+	using positions_of_pieces_type_interactive = typename engine_typeset::positions_of_pieces_type_interactive;
+
+	using positions_of_pieces_type_solver = typename engine_typeset::positions_of_pieces_type_solver;
+
+	using solver_environment_type = SolverEnvironment<pieces_quantity_type>;
+
+	using distance_exploration_type = typename solver_environment_type::distance_exploration_type;
+
+	using shared_board_type = SharedBoard<pieces_quantity_type>;
+
+	using board_rotation_type = BoardRotation<pieces_quantity_type>;
+
+	static constexpr std::size_t DEFAULT_CACHE_BYTES{ std::size_t(256) << 20 };
+
+private:
+
+	struct cache_entry {
+		const std::shared_ptr<const shared_board_type> board;
+		const positions_of_pieces_type_solver initial_state;
+
+		/** serializes all solver runs on explorer */
+		std::mutex mutex;
+		const std::shared_ptr<distance_exploration_type> explorer;
+
+		/** guarded by the session's _mutex, size of the explored states after the last solver run */
+		std::size_t bytes;
+
+		cache_entry(const std::shared_ptr<const shared_board_type>& board, const positions_of_pieces_type_solver& initial_state) :
+			board(board),
+			initial_state(initial_state),
+			mutex(),
+			explorer(std::make_shared<distance_exploration_type>(initial_state)),
+			bytes(0)
+		{}
+	};
+
+	std::mutex _mutex;
+
+	/** guarded by _mutex, most recently used first */
+	std::deque<std::shared_ptr<cache_entry>> _entries;
+
+	std::size_t _cache_bytes;
+
+	std::shared_ptr<cache_entry> entry(const std::shared_ptr<const shared_board_type>& board, const positions_of_pieces_type_solver& initial_state) {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		auto iter = std::find_if(_entries.begin(), _entries.end(), [&](const std::shared_ptr<cache_entry>& e) {
+			return e->board == board && e->initial_state == initial_state;
+			});
+
+		std::shared_ptr<cache_entry> result;
+		if (iter != _entries.end()) {
+			result = *iter;
+			_entries.erase(iter);
+		}
+		else {
+			result = std::make_shared<cache_entry>(board, initial_state);
+		}
+		_entries.push_front(result);
+		return result;
+	}
+
+	/**
+	*	@brief Records the size of \p cached after a solver run, then evicts the least recently used entries until all entries fit into the cache budget.
+	*
+	*	@details Evicted explorers stay alive while solver runs still use them.
+	*/
+	void update_size(const std::shared_ptr<cache_entry>& cached, std::size_t bytes) {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		cached->bytes = bytes;
+
+		std::size_t total_bytes{ 0 };
+		for (const auto& e : _entries) {
+			total_bytes += e->bytes;
+		}
+		while (total_bytes > _cache_bytes && !_entries.empty()) {
+			total_bytes -= _entries.back()->bytes;
+			_entries.pop_back();
+		}
+	}
+
+	inline static cell_id_type cell_from_json(const nlohmann::json& coordinates, const world_type& world) {
+		const auto x{ coordinates.at(0).get<int64_t>() };
+		const auto y{ coordinates.at(1).get<int64_t>() };
+		if (coordinates.size() != 2 || x < 0 || y < 0 || x >= world.get_horizontal_size() || y >= world.get_vertical_size()) {
+			throw std::invalid_argument("cell out of world: " + coordinates.dump());
+		}
+		return cell_id_type::create_by_coordinates(
+			static_cast<typename cell_id_type::int_cell_id_type>(x),
+			static_cast<typename cell_id_type::int_cell_id_type>(y),
+			world
+		);
+	}
+
+	template<class Array_T>
+	inline static Array_T pieces_from_json(const nlohmann::json& pieces, const world_type& world) {
+		Array_T result;
+		if (pieces.size() != result.size()) {
+			throw std::invalid_argument("wrong number of pieces: " + pieces.dump());
+		}
+		for (std::size_t i{ 0 }; i < result.size(); ++i) {
+			result[i] = cell_from_json(pieces.at(i), world);
+			if (world.blocked(result[i].get_id())) {
+				throw std::invalid_argument("piece on blocked cell: " + pieces.at(i).dump());
+			}
+		}
+		return result;
+	}
+
+public:
+
+	/**
+	*	@brief Creates a session whose cached explorers hold at most \p cache_bytes of explored states.
+	*/
+	explicit SolverSession(std::size_t cache_bytes = DEFAULT_CACHE_BYTES) : _mutex(), _entries(), _cache_bytes(cache_bytes) {}
+
+	SolverSession(const SolverSession&) = delete;
+
+	SolverSession& operator=(const SolverSession&) = delete;
+
+	/**
+	*	@brief Returns the number of cached explorers.
+	*/
+	std::size_t count_cached_explorers() {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _entries.size();
+	}
+
+	/**
+	*	@brief Returns the total size of the explored states of all cached explorers.
+	*/
+	std::size_t cached_bytes() {
+		std::lock_guard<std::mutex> lock(_mutex);
+		std::size_t result{ 0 };
+		for (const auto& e : _entries) {
+			result += e->bytes;
+		}
+		return result;
+	}
+
+	/**
+	*	@brief Reads a world from \p world_json, either {"counter": n} selecting a world of the original game generator,
+	*	or {"width": w, "height": h, "west_walls": [[x, y], ...], "south_walls": [[x, y], ...], "blocked_center": [w, h]} with optional wall lists and blocked center.
+	*
+	*	@return Returns the world and, for generated worlds, the generator's target cell.
+	*/
+	static std::pair<world_type, std::optional<cell_id_type>> world_from_json(const nlohmann::json& world_json) {
+		if (world_json.contains("counter")) {
+			const tobor::v1_1::world_generator::original_4_of_16 generator(world_json.at("counter").get<uint64_t>());
+			return std::make_pair(generator.get_tobor_world(), std::optional<cell_id_type>(generator.get_target_cell()));
+		}
+
+		const auto width{ world_json.at("width").get<int64_t>() };
+		const auto height{ world_json.at("height").get<int64_t>() };
+		if (width < 1 || height < 1 || width > 255 || height > 255) {
+			throw std::invalid_argument("invalid world size");
+		}
+		// larger worlds would alias cells, their ids do not fit into cell_id_type:
+		if (width * height > static_cast<int64_t>(std::numeric_limits<typename cell_id_type::int_cell_id_type>::max()) + 1) {
+			throw std::invalid_argument("world has too many cells");
+		}
+
+		world_type world(static_cast<typename world_type::int_size_type>(width), static_cast<typename world_type::int_size_type>(height));
+
+		if (world_json.contains("blocked_center")) {
+			const auto& blocked_center{ world_json.at("blocked_center") };
+			world.block_center_cells(blocked_center.at(0).get<typename world_type::int_size_type>(), blocked_center.at(1).get<typename world_type::int_size_type>());
+		}
+		if (world_json.contains("west_walls")) {
+			for (const auto& coordinates : world_json.at("west_walls")) {
+				world.west_wall_by_id(cell_from_json(coordinates, world).get_id()) = true;
+			}
+		}
+		if (world_json.contains("south_walls")) {
+			for (const auto& coordinates : world_json.at("south_walls")) {
+				world.south_wall_by_transposed_id(cell_from_json(coordinates, world).get_transposed_id(world)) = true;
+			}
+		}
+		return std::make_pair(world, std::nullopt);
+	}
+
+	/**
+	*	@brief Solves the game given by \p request and returns the response, both without "id".
+	*
+	*	@details Request members: "world" (see world_from_json()), "initial_state": {"target_pieces": [[x, y], ...], "non_target_pieces": [[x, y], ...]},
+	*	"target": [x, y] (optional for generated worlds), "max_depth": n >= 0 (optional), "single_solution": true (optional, returns any one optimal solution, but faster).
+	*	Response: {"status": "ok", "optimal_length": n, "solutions": [[{"piece": i, "direction": "N"}, ...], ...]} with one representant per solution class
+	*	and pieces numbered in request order, target pieces first. Or {"status": "not_found"} if max_depth was exceeded, {"status": "unsolvable"} if the target cannot be reached.
+	*	Throws on invalid requests.
+	*/
+	nlohmann::json solve(const nlohmann::json& request) {
+		const auto [world, generated_target] = world_from_json(request.at("world"));
+
+		const auto& initial_state_json{ request.at("initial_state") };
+		const auto target_pieces{ pieces_from_json<typename positions_of_pieces_type_interactive::target_pieces_array_type>(initial_state_json.at("target_pieces"), world) };
+		const auto non_target_pieces{ pieces_from_json<typename positions_of_pieces_type_interactive::non_target_pieces_array_type>(initial_state_json.at("non_target_pieces"), world) };
+		const positions_of_pieces_type_interactive initial_state(target_pieces, non_target_pieces);
+		{
+			auto cells{ initial_state.piece_positions() };
+			std::sort(cells.begin(), cells.end());
+			if (std::adjacent_find(cells.cbegin(), cells.cend()) != cells.cend()) {
+				throw std::invalid_argument("two pieces on the same cell");
+			}
+		}
+
+		cell_id_type target_cell;
+		if (request.contains("target")) {
+			target_cell = cell_from_json(request.at("target"), world);
+		}
+		else if (generated_target) {
+			target_cell = generated_target.value();
+		}
+		else {
+			throw std::invalid_argument("missing target");
+		}
+
+		// solve the canonical rotation, pieces keep their numbers:
+		const uint8_t rotation{ board_rotation_type::canonical_rotation(world, initial_state.naked()) };
+
+		const auto board{ BoardRegistry<pieces_quantity_type>::instance().get(board_rotation_type::turned_world(world, rotation)) };
+
+		const positions_of_pieces_type_interactive turned_initial_state(
+			board_rotation_type::turned_cells(target_pieces, world, rotation),
+			board_rotation_type::turned_cells(non_target_pieces, world, rotation)
+		);
+
+		const cell_id_type turned_target_cell{ board_rotation_type::turned_cell(target_cell, world, rotation) };
+
+		std::size_t max_depth{ distance_exploration_type::SIZE_TYPE_MAX };
+		if (request.contains("max_depth")) {
+			const auto& max_depth_json{ request.at("max_depth") };
+			if (!max_depth_json.is_number_integer() || (!max_depth_json.is_number_unsigned() && max_depth_json.get<int64_t>() < 0)) {
+				throw std::invalid_argument("invalid max_depth: " + max_depth_json.dump());
+			}
+			max_depth = max_depth_json.get<std::size_t>();
+		}
+
+		const auto mode{ request.value("single_solution", false) ? solver_environment_type::extraction_mode::SINGLE_SOLUTION : solver_environment_type::extraction_mode::ALL_SOLUTION_CLASSES };
+
+		const auto cached{ entry(board, turned_initial_state.naked()) };
+
+		std::lock_guard<std::mutex> lock(cached->mutex);
+
+		const solver_environment_type solver(cached->explorer, turned_initial_state, turned_target_cell, board->move_engine(), nullptr, max_depth, mode);
+
+		update_size(cached, cached->explorer->count_states() * sizeof(positions_of_pieces_type_solver));
+
+		nlohmann::json response;
+		if (solver.status_code() == 1) {
+			response["status"] = "not_found";
+			return response;
+		}
+		if (solver.status_code() != 0 || solver.solutions_size() == 0) {
+			response["status"] = "unsolvable";
+			return response;
+		}
+
+		const auto optimal_solutions{ solver.optimal_solutions() };
+
+		response["status"] = "ok";
+		response["optimal_length"] = optimal_solutions.front().second.vector().size();
+		nlohmann::json solutions = nlohmann::json::array();
+		for (const auto& [state_path, move_path] : optimal_solutions) {
+			nlohmann::json moves = nlohmann::json::array();
+			for (const auto& move : move_path.vector()) {
+				const auto dir{ board_rotation_type::turned_direction(move.dir, board_rotation_type::inverse_rotation(rotation)) };
+				moves.push_back({ { "piece", move.pid.value }, { "direction", std::string(1, dir.to_char()) } });
+			}
+			solutions.push_back(std::move(moves));
+		}
+		response["solutions"] = std::move(solutions);
+		return response;
+	}
+};
+
+/**
+*	@brief Headless solver answering JSON lines: one request per line, one response per line.
+*
+*	@details Requests are solved concurrently on a thread pool, so responses may arrive in a different order. Each response carries the "id" of its request.
+*	A request selects the piece quantity by "pieces": {"target": 1, "non_target": n} with 1 <= n <= 7, see SolverSession::solve() for the remaining members.
+*	Failing requests are answered by {"status": "error", "message": "..."}.
+*/
+class SolverDaemon {
+public:
+
+	static constexpr std::size_t MAX_NON_TARGET_PIECES{ 7 };
+
+private:
+
+	template<std::size_t COUNT_NON_TARGET_PIECES>
+	using session_type = SolverSession<tobor::v1_1::pieces_quantity<uint8_t, 1, COUNT_NON_TARGET_PIECES>>;
+
+	template<std::size_t... Index>
+	inline static std::tuple<std::unique_ptr<session_type<Index + 1>>...> make_sessions(std::size_t cache_bytes, std::index_sequence<Index...>) {
+		return std::make_tuple(std::make_unique<session_type<Index + 1>>(cache_bytes)...);
+	}
+
+	using sessions_type = decltype(make_sessions(0, std::make_index_sequence<MAX_NON_TARGET_PIECES>{}));
+
+	sessions_type _sessions;
+
+	ThreadPool _pool;
+
+	template<std::size_t... Index>
+	nlohmann::json dispatch(const std::size_t& count_non_target_pieces, const nlohmann::json& request, std::index_sequence<Index...>) {
+		nlohmann::json response;
+		const bool found{ ((count_non_target_pieces == Index + 1 ? (response = std::get<Index>(_sessions)->solve(request), true) : false) || ...) };
+		if (!found) {
+			throw std::invalid_argument("unsupported number of non-target pieces");
+		}
+		return response;
+	}
+
+	/**
+	*	@brief A client connected via Unix domain socket, closed when the reader and all its pending responses are done.
+	*/
+	struct connection {
+		int fd;
+		std::mutex write_mutex;
+
+		/** set when serve_connection() returns */
+		std::atomic<bool> reader_done{ false };
+
+		explicit connection(int fd) : fd(fd) {}
+
+		~connection() {
+#ifndef _WIN32
+			::close(fd);
+#endif
+		}
+
+		void write_line(const std::string& line) {
+#ifndef _WIN32
+			std::lock_guard<std::mutex> lock(write_mutex);
+			const std::string data{ line + '\n' };
+			std::size_t written{ 0 };
+			while (written < data.size()) {
+#ifdef MSG_NOSIGNAL
+				const auto result{ ::send(fd, data.data() + written, data.size() - written, MSG_NOSIGNAL) };
+#else
+				const auto result{ ::send(fd, data.data() + written, data.size() - written, 0) };
+#endif
+				if (result <= 0) {
+					return; // client gone
+				}
+				written += static_cast<std::size_t>(result);
+			}
+#else
+			(void)line;
+#endif
+		}
+	};
+
+	void serve_connection(std::shared_ptr<connection> client) {
+#ifndef _WIN32
+		std::string buffer;
+		char chunk[4096];
+		while (true) {
+			const auto count{ ::read(client->fd, chunk, sizeof(chunk)) };
+			if (count <= 0) {
+				break;
+			}
+			buffer.append(chunk, static_cast<std::size_t>(count));
+
+			std::size_t begin{ 0 };
+			for (std::size_t end{ buffer.find('\n') }; end != std::string::npos; end = buffer.find('\n', begin)) {
+				std::string line{ buffer.substr(begin, end - begin) };
+				begin = end + 1;
+				if (line.empty()) {
+					continue;
+				}
+				_pool.submit([this, client, line = std::move(line)]() { client->write_line(handle(line)); });
+			}
+			buffer.erase(0, begin);
+		}
+		::shutdown(client->fd, SHUT_RD);
+#else
+		(void)client;
+#endif
+		client->reader_done = true;
+	}
+
+	/**
+	*	@brief Reader thread of a client.
+	*/
+	struct connection_thread {
+		std::shared_ptr<connection> client;
+		std::thread thread;
+	};
+
+	std::mutex _connections_mutex;
+
+	/** guarded by _connections_mutex, joined on destruction, finished ones when the next client connects */
+	std::list<connection_thread> _connections;
+
+public:
+
+	/**
+	*	@brief Creates a daemon solving on \p count_threads threads. Each quantity of pieces caches at most \p cache_bytes of explored states, see SolverSession.
+	*/
+	explicit SolverDaemon(std::size_t count_threads = std::thread::hardware_concurrency(), std::size_t cache_bytes = session_type<1>::DEFAULT_CACHE_BYTES) :
+		_sessions(make_sessions(cache_bytes, std::make_index_sequence<MAX_NON_TARGET_PIECES>{})),
+		_pool(count_threads),
+		_connections_mutex(),
+		_connections()
+	{}
+
+	SolverDaemon(const SolverDaemon&) = delete;
+
+	SolverDaemon& operator=(const SolverDaemon&) = delete;
+
+	/**
+	*	@brief Disconnects all clients and waits for their reader threads. Pending responses are still solved, but not delivered.
+	*/
+	~SolverDaemon() {
+		std::lock_guard<std::mutex> lock(_connections_mutex);
+		for (auto& c : _connections) {
+#ifndef _WIN32
+			::shutdown(c.client->fd, SHUT_RDWR); // ends the blocking read
+#endif
+			c.thread.join();
+		}
+		_connections.clear();
+	}
+
+	/**
+	*	@brief Answers one request line. Never throws.
+	*/
+	std::string handle(const std::string& line) {
+		nlohmann::json response;
+		nlohmann::json id;
+		try {
+			const nlohmann::json request = nlohmann::json::parse(line);
+			if (request.is_object() && request.contains("id")) {
+				id = request.at("id");
+			}
+			const auto& pieces{ request.at("pieces") };
+			if (pieces.at("target").get<int64_t>() != 1) {
+				throw std::invalid_argument("unsupported number of target pieces");
+			}
+			response = dispatch(pieces.at("non_target").get<std::size_t>(), request, std::make_index_sequence<MAX_NON_TARGET_PIECES>{});
+		}
+		catch (const std::exception& e) {
+			response = nlohmann::json();
+			response["status"] = "error";
+			response["message"] = e.what();
+		}
+		if (!id.is_null()) {
+			response["id"] = id;
+		}
+		// error messages may quote invalid UTF-8 from the request line:
+		return response.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+	}
+
+	/**
+	*	@brief Answers all request lines from \p in on \p out until end of input, then waits for the pending responses.
+	*/
+	void serve(std::istream& in, std::ostream& out) {
+		std::mutex out_mutex;
+		std::string line;
+		while (std::getline(in, line)) {
+			if (line.empty()) {
+				continue;
+			}
+			_pool.submit([this, &out, &out_mutex, line]() {
+				const std::string response{ handle(line) };
+				std::lock_guard<std::mutex> lock(out_mutex);
+				out << response << '\n' << std::flush;
+				});
+		}
+		_pool.wait();
+	}
+
+	/**
+	*	@brief Serves the connected socket \p fd like serve() on a thread of its own, and closes it when done.
+	*/
+	void serve_client(int fd) {
+		const auto client{ std::make_shared<connection>(fd) };
+
+		std::lock_guard<std::mutex> lock(_connections_mutex);
+		for (auto iter = _connections.begin(); iter != _connections.end();) {
+			if (iter->client->reader_done) {
+				iter->thread.join();
+				iter = _connections.erase(iter);
+			}
+			else {
+				++iter;
+			}
+		}
+		_connections.push_back(connection_thread{ client, std::thread(&SolverDaemon::serve_connection, this, client) });
+	}
+
+	/**
+	*	@brief Listens on a Unix domain socket at \p path, replacing an existing file, and serves each client like serve(). Only returns by throwing std::runtime_error.
+	*/
+	[[noreturn]] void serve_unix_socket(const std::string& path) {
+#ifndef _WIN32
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		if (path.size() >= sizeof(address.sun_path)) {
+			throw std::runtime_error("Socket path too long: " + path);
+		}
+		std::copy(path.cbegin(), path.cend(), address.sun_path);
+
+		const int listen_fd{ ::socket(AF_UNIX, SOCK_STREAM, 0) };
+		if (listen_fd < 0) {
+			throw std::runtime_error("Cannot create socket");
+		}
+		::unlink(path.c_str());
+		if (::bind(listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listen_fd, 16) != 0) {
+			::close(listen_fd);
+			throw std::runtime_error("Cannot listen on socket " + path);
+		}
+
+		while (true) {
+			const int client_fd{ ::accept(listen_fd, nullptr, nullptr) };
+			if (client_fd < 0) {
+				continue;
+			}
+			serve_client(client_fd);
+		}
+#else
+		throw std::runtime_error("Unix domain sockets are not supported on this platform: " + path);
+#endif
+	}
+};
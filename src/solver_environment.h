@@ -6,27 +6,35 @@
 #include "engine/distance_exploration.h"
 
 #include "engine_typeset.h"
+#include "trace.h"
 
+#include <algorithm>
 #include <functional>
+#include <map>
+#include <memory>
+#include <memory_resource>
 #include <optional>
+#include <stdexcept>
 
 /**
 *	@brief Encapsulation of solver usage, RAII friendly, for specific initial state and target cell.
 *
 *	@details Runs the solver on construction to produce a vector of optimal solutions.
 */
-template<class Pieces_Quantity_T>
+template<class Pieces_Quantity_T, class Engine_Type_Set_T = ClassicEngineTypeSet<Pieces_Quantity_T>>
 class SolverEnvironment {
 public:
 
 
-	using engine_typeset = ClassicEngineTypeSet<Pieces_Quantity_T>;
+	using engine_typeset = Engine_Type_Set_T;
 
 
 	using state_path_type_interactive = typename engine_typeset::state_path_type_interactive;
 
 	using state_path_type_solver = typename engine_typeset::state_path_type_solver;
 
+	using compact_state_path_type_interactive = typename engine_typeset::compact_state_path_type_interactive;
+
 	using move_path_type = typename engine_typeset::move_path_type;
 
 	using positions_of_pieces_type_interactive = typename engine_typeset::positions_of_pieces_type_interactive;
@@ -51,6 +59,16 @@ public:
 
 	using optimal_solutions_vector = std::vector<std::pair<state_path_type_interactive, move_path_type>>;
 
+	using distance_exploration_type = tobor::v1_1::distance_exploration<move_engine_type, positions_of_pieces_type_solver>;
+
+	/**
+	*	@brief Selects which optimal solutions are extracted from the explored state space.
+	*/
+	enum class extraction_mode {
+		ALL_SOLUTION_CLASSES, // the prettiest representant of each equivalence class of optimal solutions
+		SINGLE_SOLUTION // any one optimal solution, skipping solution graph extraction and partitioning
+	};
+
 
 private:
 
@@ -77,8 +95,6 @@ private:
 
 	using piece_change_decoration_vector = std::vector<piece_change_decoration>;
 
-	using distance_exploration_type = tobor::v1_1::distance_exploration<move_engine_type, positions_of_pieces_type_solver>;
-
 	using bigraph_type = tobor::v1_1::simple_state_digraph<positions_of_pieces_type_solver, std::vector<bool>>;
 
 	using naked_bigraph_type = tobor::v1_1::simple_state_digraph<positions_of_pieces_type_solver, void>;
@@ -89,6 +105,19 @@ private:
 
 	using path_classificator_type = tobor::v1_1::path_classificator<positions_of_pieces_type_solver>;
 
+	using layered_state_type = tobor::v1_1::layered_state<positions_of_pieces_type_solver>;
+
+	using layered_bigraph_type = tobor::v1_1::simple_state_digraph<layered_state_type, std::vector<bool>>;
+
+	using naked_layered_bigraph_type = tobor::v1_1::simple_state_digraph<layered_state_type, void>;
+
+	using layered_path_classificator_type = tobor::v1_1::path_classificator<layered_state_type>;
+
+
+	/**
+	*	@brief Like optimal_solutions_vector, but with compact state paths, materialized on demand.
+	*/
+	using compact_solutions_vector = std::vector<std::pair<compact_state_path_type_interactive, move_path_type>>;
 
 	/** data **/
 
@@ -100,9 +129,14 @@ private:
 
 	uint8_t _status_code;
 
-	distance_exploration_type _distance_explorer;
+	extraction_mode _extraction_mode;
+
+	/**
+	*	@brief May be shared with other solver environments for the same initial state, which then continue from its explored levels and cached target distances.
+	*/
+	std::shared_ptr<distance_exploration_type> _distance_explorer;
 
-	optimal_solutions_vector _optimal_solutions;
+	compact_solutions_vector _optimal_solutions;
 
 
 	/**
@@ -205,17 +239,24 @@ private:
 	}
 
 
+	/**
+	*	@brief Selects a representant for each partition by dynamic programming on decorated copies of \p partition_bigraphs, which are allocated from \p arena.
+	*/
 	inline uint8_t dynamic_programming_prettiness_evaluation(
 		const std::vector<naked_bigraph_type>& partition_bigraphs,
+		std::pmr::memory_resource* arena,
 		std::function<void(const std::string&)> status_callback = nullptr
 	) {
+		TOBOR_TRACE_SCOPE("SolverEnvironment::dynamic_programming_prettiness_evaluation");
+
 		std::vector<pretty_evaluation_bigraph_type> partition_bigraphs_decorated;
+		partition_bigraphs_decorated.reserve(partition_bigraphs.size());
 
 		for (std::size_t i{ 0 }; i < partition_bigraphs.size(); ++i) {
 
 			if (status_callback) status_callback("Simulation-copying from solver state type to interactive state type of partition graphs...");
 			// simulation copy here
-			partition_bigraphs_decorated.emplace_back();
+			partition_bigraphs_decorated.emplace_back(arena);
 			auto iter_to_single_initial_state = tobor::v1_1::bigraph_operations::bigraph_simulation_copy<positions_of_pieces_type_solver, void, positions_of_pieces_type_interactive, piece_change_decoration_vector, cell_id_type, quick_move_cache_type, piece_move_type>::
 				copy(partition_bigraphs[i], partition_bigraphs_decorated[i], _initial_state, _move_engine);
 
@@ -227,15 +268,29 @@ private:
 
 			const move_path_type color_aware_move_path{ move_path_type::extract_unsorted_move_path(representant, _move_engine) };
 
-			_optimal_solutions.emplace_back(representant, color_aware_move_path);
+			_optimal_solutions.emplace_back(compact_state_path_type_interactive(_move_engine, representant), color_aware_move_path);
 		}
 		return 0; // status code: OK
 	}
 
+	/**
+	*	@brief Returns the augmented state path and the color-aware move path of \p state_path.
+	*/
+	inline std::pair<state_path_type_interactive, move_path_type> color_aware_solution(const state_path_type_solver& state_path) const {
+		const move_path_type color_agnostic_move_path{ move_path_type(state_path, _move_engine) };
+
+		const state_path_type_interactive augmented_state_path{ color_agnostic_move_path.apply(_initial_state, _move_engine) };
+
+		const move_path_type color_aware_move_path{ move_path_type::extract_unsorted_move_path(augmented_state_path, _move_engine) };
+
+		return std::make_pair(augmented_state_path, color_aware_move_path);
+	}
+
 	inline uint8_t explicit_move_path_prettiness_evaluation(
 		const std::vector<naked_bigraph_type>& partition_bigraphs,
 		std::function<void(const std::string&)> status_callback = nullptr
 	) {
+		TOBOR_TRACE_SCOPE("SolverEnvironment::explicit_move_path_prettiness_evaluation");
 
 		std::vector<std::vector<state_path_type_solver>> partitioned_state_paths;
 
@@ -253,14 +308,7 @@ private:
 			partitioned_path_pairs.emplace_back();
 
 			for (const auto& state_path : partitioned_state_paths[i]) {
-
-				const move_path_type color_agnostic_move_path{ move_path_type(state_path, _move_engine) };
-
-				const state_path_type_interactive augmented_state_path{ color_agnostic_move_path.apply(_initial_state, _move_engine) };
-
-				const move_path_type color_aware_move_path{ move_path_type::extract_unsorted_move_path(augmented_state_path, _move_engine) };
-
-				partitioned_path_pairs.back().emplace_back(augmented_state_path, color_aware_move_path);
+				partitioned_path_pairs.back().push_back(color_aware_solution(state_path));
 			}
 		}
 
@@ -268,7 +316,7 @@ private:
 		for (auto& equivalence_class : partitioned_path_pairs) {
 			auto min_iter = std::min_element(equivalence_class.begin(), equivalence_class.end(), [](const auto& pair_l, const auto& pair_r) { return move_path_type::antiprettiness_relation(pair_l.second, pair_r.second); });
 			if (min_iter != equivalence_class.end()) {
-				_optimal_solutions.push_back(*min_iter);
+				_optimal_solutions.emplace_back(compact_state_path_type_interactive(_move_engine, min_iter->first), min_iter->second);
 			}
 		}
 
@@ -277,43 +325,171 @@ private:
 		return 0; // status code: OK
 	}
 
+	/**
+	*	@brief Extracts the representants of all optimal solution classes from the explored state space.
+	*
+	*	@details All graphs of this step live in one monotonic arena: allocating is a pointer bump, and the arena is released at once on return instead of node by node.
+	*/
 	inline uint8_t extract_solution_from_state_space(
 		std::function<void(const std::string&)> status_callback = nullptr,
 		uint8_t SELECT_STRATEGY = 0
 	) {
+		TOBOR_TRACE_SCOPE("SolverEnvironment::extract_solution_from_state_space");
+
+		std::pmr::monotonic_buffer_resource arena; // declared first, so it is destroyed after all graphs
 
-		bigraph_type bigraph;
+		bigraph_type bigraph(&arena);
 
 		if (status_callback) status_callback("Extracting solution state graph...");
-		_distance_explorer.get_simple_bigraph(_move_engine, _target_cell, bigraph);
+		_distance_explorer->get_simple_bigraph(_move_engine, _target_cell, bigraph);
 
 		// bigraph is now a sub - bigraph of exploration space where all states are decorated with an empty std::vector<bool>
 
 		if (status_callback) status_callback("Partition optimal solutions...");
-		std::size_t count_partitions = path_classificator_type::make_state_graph_path_partitioning(bigraph);
+		std::size_t count_partitions;
+		{
+			TOBOR_TRACE_SCOPE("SolverEnvironment::partition");
+			count_partitions = path_classificator_type::make_state_graph_path_partitioning(bigraph);
+		}
 
 		// bigraph decoration std::vector<bool> now assigns a "color" (= index of vector where bit is set true) to every state of a partition of solution paths
 
 		std::vector<naked_bigraph_type> partition_bigraphs;
+		partition_bigraphs.reserve(count_partitions);
 
 		if (status_callback) status_callback("Extracting subgraph for each partition...");
 		for (std::size_t i{ 0 }; i < count_partitions; ++i) {
-			partition_bigraphs.emplace_back();
+			partition_bigraphs.emplace_back(&arena);
 			path_classificator_type::extract_subgraph_by_label(bigraph, i, partition_bigraphs.back());
 		}
 
 		// Now in partition_bigraphs there is a separate bigraph for each color i.e. for each partition.
 
 		if (SELECT_STRATEGY == 0) {
-			return dynamic_programming_prettiness_evaluation(partition_bigraphs, status_callback);
+			return dynamic_programming_prettiness_evaluation(partition_bigraphs, &arena, status_callback);
 		}
 		else if (SELECT_STRATEGY == 1) {
 			return explicit_move_path_prettiness_evaluation(partition_bigraphs, status_callback);
 		}
 		else {
 			// DEFAULT
-			return dynamic_programming_prettiness_evaluation(partition_bigraphs, status_callback);
+			return dynamic_programming_prettiness_evaluation(partition_bigraphs, &arena, status_callback);
+		}
+	}
+
+	/**
+	*	@brief Extracts one optimal solution from the explored state space, walking back from one final state only.
+	*/
+	inline uint8_t extract_single_solution_from_state_space(std::function<void(const std::string&)> status_callback = nullptr) {
+		TOBOR_TRACE_SCOPE("SolverEnvironment::extract_single_solution_from_state_space");
+
+		if (status_callback) status_callback("Extracting one optimal solution...");
+		const auto [augmented_state_path, color_aware_move_path] { color_aware_solution(_distance_explorer->optimal_state_path(_move_engine, _target_cell)) };
+
+		_optimal_solutions.emplace_back(compact_state_path_type_interactive(_move_engine, augmented_state_path), color_aware_move_path);
+
+		return 0; // status code: OK
+	}
+
+	/**
+	*	@brief Returns the cell of the piece moved from \p from_state to \p to_state, after the move.
+	*/
+	inline static cell_id_type moved_piece_cell(const positions_of_pieces_type_solver& from_state, const positions_of_pieces_type_solver& to_state) {
+		const auto& from_cells{ from_state.piece_positions() };
+		for (const auto& cell : to_state.piece_positions()) {
+			if (std::find(from_cells.cbegin(), from_cells.cend(), cell) == from_cells.cend()) {
+				return cell;
+			}
+		}
+		throw std::invalid_argument("SolverEnvironment: states do not differ");
+	}
+
+	/**
+	*	@brief Selects a path of the layered \p graph with the least piece changes, among the paths without any move directly undone by the next one.
+	*
+	*	@details Dynamic programming over the edges, from the last layer backwards. Two successive moves move the same piece if and only if the second starts where the first ends.
+	*	Returns no path if there is none without undone moves.
+	*/
+	static std::optional<state_path_type_solver> near_optimal_representant(const naked_layered_bigraph_type& graph) {
+		using edge_type = std::pair<const layered_state_type*, const layered_state_type*>;
+
+		// per edge: least piece changes of any continuation from the edge's end, and the next state of that continuation (nullptr at the end)
+		std::map<edge_type, std::pair<std::size_t, const layered_state_type*>> best;
+
+		std::vector<typename naked_layered_bigraph_type::map_const_iterator_type> nodes;
+		for (auto iter = graph.map.cbegin(); iter != graph.map.cend(); ++iter) {
+			nodes.push_back(iter);
+		}
+		std::sort(nodes.begin(), nodes.end(), [](const auto& l, const auto& r) { return l->first.layer > r->first.layer; });
+
+		const layered_state_type* root{ nullptr };
+
+		for (const auto& node : nodes) {
+			const auto& [state, links] { *node };
+
+			if (state.layer == 0) {
+				root = &state;
+			}
+
+			for (const auto& predecessor : links.predecessors) {
+				const cell_id_type arrival_cell{ moved_piece_cell(predecessor.state, state.state) };
+
+				std::optional<std::pair<std::size_t, const layered_state_type*>> continuation;
+				if (links.successors.empty()) {
+					continuation.emplace(0, nullptr);
+				}
+				for (const auto& successor : links.successors) {
+					if (successor.state == predecessor.state) {
+						continue; // move undone
+					}
+					const auto iter = graph.map.find(successor);
+					const auto jter = best.find(edge_type(&state, &iter->first));
+					if (jter == best.cend()) {
+						continue; // no continuation without undone moves
+					}
+					const cell_id_type departure_cell{ moved_piece_cell(successor.state, state.state) }; // the cell left by the next move
+					const std::size_t changes{ jter->second.first + (departure_cell != arrival_cell) };
+					if (!continuation.has_value() || changes < continuation->first) {
+						continuation.emplace(changes, &iter->first);
+					}
+				}
+				if (continuation.has_value()) {
+					best.emplace(edge_type(&graph.map.find(predecessor)->first, &state), continuation.value());
+				}
+			}
 		}
+
+		if (root == nullptr) {
+			return std::nullopt;
+		}
+
+		typename state_path_type_solver::vector_type states{ root->state };
+
+		const auto& root_links{ graph.map.find(*root)->second };
+		std::optional<std::pair<std::size_t, const layered_state_type*>> first;
+		for (const auto& successor : root_links.successors) {
+			const layered_state_type* next{ &graph.map.find(successor)->first };
+			const auto jter = best.find(edge_type(root, next));
+			if (jter != best.cend() && (!first.has_value() || jter->second.first < first->first)) {
+				first.emplace(jter->second.first, next);
+			}
+		}
+		if (!first.has_value()) {
+			if (!root_links.successors.empty()) {
+				return std::nullopt;
+			}
+			return state_path_type_solver(states);
+		}
+
+		const layered_state_type* previous{ root };
+		const layered_state_type* current{ first->second };
+		while (current != nullptr) {
+			states.push_back(current->state);
+			const layered_state_type* next{ best.at(edge_type(previous, current)).second };
+			previous = current;
+			current = next;
+		}
+		return state_path_type_solver(states);
 	}
 
 	inline uint8_t run_solver_toolchain(
@@ -321,18 +497,25 @@ private:
 		std::size_t MAX_DEPTH = distance_exploration_type::SIZE_TYPE_MAX,
 		uint8_t SELECT_STRATEGY = 0
 	) {
+		TOBOR_TRACE_SCOPE("SolverEnvironment::run_solver_toolchain");
 
 		// explore...
 		if (status_callback) status_callback("Exploring state space until target...");
-		auto optimal_depth = _distance_explorer.explore_until_target(_move_engine, _target_cell, MAX_DEPTH);
+		auto optimal_depth = _distance_explorer->explore_until_target(_move_engine, _target_cell, MAX_DEPTH);
 		// ### inside this call, log every distance level as a progress bar
 
 
-		if (optimal_depth == decltype(_distance_explorer)::SIZE_TYPE_MAX) {
+		if (optimal_depth == distance_exploration_type::SIZE_TYPE_MAX) {
 			// did not find any solution whithin MAX_DEPTH
+			if (_distance_explorer->entirely_explored()) {
+				return _status_code = 2; // NOT FOUND, ALL REACHABLE STATES EXPLORED
+			}
 			return _status_code = 1; // NOT FOUND WITHIN MAX_DEPTH
 		}
 
+		if (_extraction_mode == extraction_mode::SINGLE_SOLUTION) {
+			return _status_code = extract_single_solution_from_state_space(status_callback);
+		}
 		return _status_code = extract_solution_from_state_space(status_callback, SELECT_STRATEGY);
 	}
 
@@ -346,15 +529,37 @@ public:
 		const cell_id_type& target_cell,
 		const move_engine_type& move_engine,
 		std::function<void(const std::string&)> status_callback = nullptr,
-		std::size_t MAX_DEPTH = distance_exploration_type::SIZE_TYPE_MAX
+		std::size_t MAX_DEPTH = distance_exploration_type::SIZE_TYPE_MAX,
+		extraction_mode mode = extraction_mode::ALL_SOLUTION_CLASSES
+	) :
+		SolverEnvironment(std::make_shared<distance_exploration_type>(initial_state.naked()), initial_state, target_cell, move_engine, status_callback, MAX_DEPTH, mode)
+	{}
+
+	/**
+	*	@brief Constructs a SolverEnvironment object, running the solver for a specified initial state and target cell, continuing the exploration of \p distance_explorer.
+	*
+	*	@details \p distance_explorer must have been started from \p initial_state, otherwise std::invalid_argument is thrown. It may have been used for other target cells before.
+	*/
+	SolverEnvironment(
+		std::shared_ptr<distance_exploration_type> distance_explorer,
+		const positions_of_pieces_type_interactive& initial_state,
+		const cell_id_type& target_cell,
+		const move_engine_type& move_engine,
+		std::function<void(const std::string&)> status_callback = nullptr,
+		std::size_t MAX_DEPTH = distance_exploration_type::SIZE_TYPE_MAX,
+		extraction_mode mode = extraction_mode::ALL_SOLUTION_CLASSES
 	) :
 		_initial_state(initial_state),
 		_target_cell(target_cell),
 		_move_engine(move_engine),
 		_status_code(0),
-		_distance_explorer(initial_state.naked()),
+		_extraction_mode(mode),
+		_distance_explorer(std::move(distance_explorer)),
 		_optimal_solutions()
 	{
+		if (!_distance_explorer || !(_distance_explorer->initial_state() == _initial_state.naked())) {
+			throw std::invalid_argument("SolverEnvironment: distance explorer does not start from the initial state");
+		}
 		run_solver_toolchain(status_callback, MAX_DEPTH, 0);
 	}
 
@@ -362,12 +567,37 @@ public:
 	*	@brief Reruns the solver in case it did not reach the target cell yet due to given depth limitation.
 	*/
 	inline void advance_max_depth(std::function<void(const std::string&)> status_callback = nullptr, const std::size_t MAX_DEPTH = distance_exploration_type::SIZE_TYPE_MAX) {
-		if (_status_code == 0) {
+		if (_status_code != 1) {
 			return;
 		}
 		run_solver_toolchain(status_callback, MAX_DEPTH, 0);
 	}
 
+	/**
+	*	@brief Extracts the representants of all solution classes in case only a single solution was extracted so far.
+	*
+	*	@details Reuses the explored state space, so there is no further exploration. Replaces the single solution.
+	*	If no solution has been found yet, a later advance_max_depth() extracts all solution classes.
+	*/
+	inline void extract_all_solutions(std::function<void(const std::string&)> status_callback = nullptr) {
+		if (_extraction_mode == extraction_mode::ALL_SOLUTION_CLASSES) {
+			return;
+		}
+		_extraction_mode = extraction_mode::ALL_SOLUTION_CLASSES;
+		if (_status_code != 0) {
+			return;
+		}
+		_optimal_solutions.clear();
+		_status_code = extract_solution_from_state_space(status_callback, 0);
+	}
+
+	/**
+	*	@brief Returns true if and only if solutions are extracted for all solution classes, see extraction_mode.
+	*/
+	[[nodiscard]] bool all_solutions_extracted() const {
+		return _extraction_mode == extraction_mode::ALL_SOLUTION_CLASSES;
+	}
+
 	/**
 	*	@brief Returns the number of solutions found by solving.
 	*/
@@ -383,11 +613,26 @@ public:
 		return _status_code;
 	}
 
+	/**
+	*	@brief Returns the distance explorer, to be passed to another SolverEnvironment for the same initial state.
+	*/
+	[[nodiscard]] const std::shared_ptr<distance_exploration_type>& distance_explorer() const {
+		return _distance_explorer;
+	}
+
 	/**
 	*	@brief Returns an optimal solution state path.
 	*	@param index has to be less than \p solution_size()
 	*/
 	[[nodiscard]] state_path_type_interactive get_solution_state_path(std::size_t index) const {
+		return _optimal_solutions[index].first.expand();
+	}
+
+	/**
+	*	@brief Returns an optimal solution state path in compact representation, without materializing its states.
+	*	@param index has to be less than \p solution_size()
+	*/
+	[[nodiscard]] const compact_state_path_type_interactive& get_compact_solution_state_path(std::size_t index) const {
 		return _optimal_solutions[index].first;
 	}
 
@@ -396,7 +641,51 @@ public:
 	*	@details Note, unless https://github.com/Necktschnagge/tobor-games/issues/167 has been fixed,equivalence classes arising from crossing two other equivalence classes may be omitted as long as we cover all segments of optimal solutions.
 	*/
 	[[nodiscard]] optimal_solutions_vector optimal_solutions() const {
-		return _optimal_solutions;
+		optimal_solutions_vector result;
+		result.reserve(_optimal_solutions.size());
+		for (const auto& [compact_path, move_path] : _optimal_solutions) {
+			result.emplace_back(compact_path.expand(), move_path);
+		}
+		return result;
 	}
-};
 
+	/**
+	*	@brief Returns a representant for each equivalence class of all solutions of length optimal + \p slack, in the same format as optimal_solutions().
+	*
+	*	@details Explores \p slack levels beyond the optimal depth, reusing the explored state space, see distance_exploration::get_near_optimal_bigraph().
+	*	Solutions passing a final state before their end or directly undoing a move are omitted. For \p slack <= 2 this omits all solutions revisiting a state.
+	*	The representant of each class is a solution with the least piece changes. Returns an empty vector if no optimal solution has been found.
+	*/
+	[[nodiscard]] optimal_solutions_vector near_optimal_solutions(std::size_t slack, std::function<void(const std::string&)> status_callback = nullptr) {
+		TOBOR_TRACE_SCOPE("SolverEnvironment::near_optimal_solutions");
+
+		optimal_solutions_vector result;
+
+		if (_status_code != 0) {
+			return result;
+		}
+
+		std::pmr::monotonic_buffer_resource arena;
+
+		layered_bigraph_type bigraph(&arena);
+
+		if (status_callback) status_callback("Extracting near-optimal solution state graph...");
+		_distance_explorer->get_near_optimal_bigraph(_move_engine, _target_cell, slack, bigraph);
+
+		if (status_callback) status_callback("Partition near-optimal solutions...");
+		const std::size_t count_partitions{ layered_path_classificator_type::make_state_graph_path_partitioning(bigraph) };
+
+		if (status_callback) status_callback("Selecting partition representants...");
+		for (std::size_t i{ 0 }; i < count_partitions; ++i) {
+			naked_layered_bigraph_type partition_bigraph(&arena);
+			layered_path_classificator_type::extract_subgraph_by_label(bigraph, i, partition_bigraph);
+
+			const auto representant{ near_optimal_representant(partition_bigraph) };
+			if (representant.has_value()) {
+				result.push_back(color_aware_solution(representant.value()));
+			}
+		}
+
+		return result;
+	}
+};
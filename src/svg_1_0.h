@@ -5,8 +5,11 @@
 
 #include "logger.h"
 
+#include <array>
+#include <charconv>
 #include <string>
 #include <numeric>
+#include <type_traits>
 
 #include <fstream>
 
@@ -22,17 +25,46 @@ namespace tobor {
 
 		namespace svg {
 
+			/**
+			*	@brief Appends \p number to \p out, formatted like std::to_string does in the "C" locale.
+			*/
+			template<class Number>
+			inline void append_number(std::string& out, const Number& number) {
+				std::array<char, 64> buffer;
+				std::to_chars_result result;
+				if constexpr (std::is_floating_point_v<Number>) {
+					result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), number, std::chars_format::fixed, 6);
+				}
+				else {
+					result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), number);
+				}
+				out.append(buffer.data(), result.ptr);
+			}
+
 			class svg_generator {
 			public:
-				virtual std::string get_svg() const = 0;
+
+				/**
+				*	@brief Appends the svg code of this generator to \p out.
+				*/
+				virtual void write_svg(std::string& out) const = 0;
+
+				/**
+				*	@brief Returns the svg code of this generator.
+				*/
+				inline std::string get_svg() const {
+					std::string result;
+					write_svg(result);
+					return result;
+				}
 
 				virtual ~svg_generator() {}
 			};
 
 			class xml_version final : public svg_generator {
 			public:
-				virtual std::string get_svg() const override {
-					return R"xxx(<?xml version="1.0" standalone="no"?>
+				virtual void write_svg(std::string& out) const override {
+					out += R"xxx(<?xml version="1.0" standalone="no"?>
 )xxx";
 				}
 			};
@@ -43,17 +75,6 @@ namespace tobor {
 			*/
 			class svg_environment : public svg_generator {
 
-				static std::string wrap_svg(const std::string& height, const std::string& width, const std::string& nested_content) {
-					return std::string(R"---(<svg height=")---")
-						+ height
-						+ R"---(" width=")---"
-						+ width
-						+ R"---(" version="1.1" xmlns="http://www.w3.org/2000/svg">
-)---"
-+ nested_content
-+ "</svg>";
-				}
-
 				std::unique_ptr<xml_version> header;
 				std::unique_ptr<svg_generator> body;
 				std::string height;
@@ -68,8 +89,16 @@ namespace tobor {
 					width(width)
 				{}
 
-				virtual std::string get_svg() const override {
-					return header->get_svg() + wrap_svg(height, width, body->get_svg());
+				virtual void write_svg(std::string& out) const override {
+					header->write_svg(out);
+					out += R"---(<svg height=")---";
+					out += height;
+					out += R"---(" width=")---";
+					out += width;
+					out += R"---(" version="1.1" xmlns="http://www.w3.org/2000/svg">
+)---";
+					body->write_svg(out);
+					out += "</svg>";
 				}
 
 			};
@@ -90,14 +119,38 @@ namespace tobor {
 					((void)elements.push_back(std::forward<T>(init)), ...);
 				}
 
-				virtual std::string get_svg() const override {
-					return std::accumulate(
-						elements.cbegin(),
-						elements.cend(),
-						std::string(),
-						[](const std::string& acc, const u_ptr& el) {
-							return acc + el->get_svg();
-						});
+				virtual void write_svg(std::string& out) const override {
+					for (const u_ptr& el : elements) {
+						el->write_svg(out);
+					}
+				}
+			};
+
+			/**
+			*	@brief Group moving all its elements by ( \p x , \p y ).
+			*/
+			class svg_translation : public svg_generator {
+
+				double x;
+				double y;
+				std::unique_ptr<svg_generator> body;
+
+			public:
+
+				svg_translation(double x, double y, std::unique_ptr<svg_generator> body) :
+					x(x),
+					y(y),
+					body(std::move(body))
+				{}
+
+				virtual void write_svg(std::string& out) const override {
+					out += R"---(<g transform="translate()---";
+					append_number(out, x);
+					out += ' ';
+					append_number(out, y);
+					out += R"---()">)---";
+					body->write_svg(out);
+					out += "</g>";
 				}
 			};
 
@@ -114,8 +167,8 @@ namespace tobor {
 					this->primitive = primitive_p;
 				}
 
-				virtual std::string get_svg() const override {
-					return primitive;
+				virtual void write_svg(std::string& out) const override {
+					out += primitive;
 				}
 			};
 
@@ -124,7 +177,16 @@ namespace tobor {
 
 			public:
 
-				virtual std::string str() const = 0;
+				/**
+				*	@brief Appends the path data of this element to \p out.
+				*/
+				virtual void write(std::string& out) const = 0;
+
+				inline std::string str() const {
+					std::string result;
+					write(result);
+					return result;
+				}
 
 				virtual std::shared_ptr<svg_path_element> clone() const = 0;
 
@@ -150,12 +212,14 @@ namespace tobor {
 
 					M() : M(0, 0) {}
 
-					virtual std::string str() const override {
-						return std::accumulate(coordinates.cbegin(), coordinates.cend(), std::string("M"),
-							[](const std::string& acc, const std::pair<Number, Number>& el) -> std::string {
-								return acc + " " + std::to_string(el.first) + " " + std::to_string(el.second);
-							}
-						);
+					virtual void write(std::string& out) const override {
+						out += 'M';
+						for (const auto& [x, y] : coordinates) {
+							out += ' ';
+							append_number(out, x);
+							out += ' ';
+							append_number(out, y);
+						}
 					}
 
 					virtual std::shared_ptr<svg_path_element> clone() const override {
@@ -171,8 +235,8 @@ namespace tobor {
 
 					Z() {}
 
-					virtual std::string str() const override {
-						return "Z";
+					virtual void write(std::string& out) const override {
+						out += 'Z';
 					}
 
 					virtual std::shared_ptr<svg_path_element> clone() const override {
@@ -210,12 +274,14 @@ namespace tobor {
 						add_coordinates(std::forward<_Rest>(others) ...);
 					}
 
-					virtual std::string str() const override {
-						return std::accumulate(coordinates.cbegin(), coordinates.cend(), std::string("l"),
-							[](const std::string& acc, const std::pair<Number, Number>& el) -> std::string {
-								return acc + " " + std::to_string(el.first) + " " + std::to_string(el.second);
-							}
-						);
+					virtual void write(std::string& out) const override {
+						out += 'l';
+						for (const auto& [x, y] : coordinates) {
+							out += ' ';
+							append_number(out, x);
+							out += ' ';
+							append_number(out, y);
+						}
 					}
 
 					virtual std::shared_ptr<svg_path_element> clone() const override {
@@ -270,16 +336,14 @@ namespace tobor {
 						add_coordinates(std::forward<_Rest>(others) ...);
 					}
 
-					virtual std::string str() const override {
-						return std::accumulate(coordinates.cbegin(), coordinates.cend(), std::string("c"),
-							[](const std::string& acc, const std::array<Number, 6>& el) -> std::string {
-								std::string result = acc;
-								for (std::size_t i = 0; i < 6; ++i) {
-									result += " " + std::to_string(el[i]);
-								}
-								return result;
+					virtual void write(std::string& out) const override {
+						out += 'c';
+						for (const std::array<Number, 6>& el : coordinates) {
+							for (const Number& number : el) {
+								out += ' ';
+								append_number(out, number);
 							}
-						);
+						}
 					}
 
 					virtual std::shared_ptr<svg_path_element> clone() const override {
@@ -334,16 +398,14 @@ namespace tobor {
 						add_coordinates(std::forward<_Rest>(others) ...);
 					}
 
-					virtual std::string str() const override {
-						return std::accumulate(coordinates.cbegin(), coordinates.cend(), std::string("C"),
-							[](const std::string& acc, const std::array<Number, 6>& el) -> std::string {
-								std::string result = acc;
-								for (std::size_t i = 0; i < 6; ++i) {
-									result += " " + std::to_string(el[i]);
-								}
-								return result;
+					virtual void write(std::string& out) const override {
+						out += 'C';
+						for (const std::array<Number, 6>& el : coordinates) {
+							for (const Number& number : el) {
+								out += ' ';
+								append_number(out, number);
 							}
-						);
+						}
 					}
 
 					virtual std::shared_ptr<svg_path_element> clone() const override {
@@ -368,14 +430,26 @@ namespace tobor {
 						double x;
 						double y;
 
-						std::string str() const noexcept {
-							return std::to_string(rx) + " " +
-								std::to_string(ry) + " " +
-								std::to_string(x_axis_rotation) + " " +
-								std::to_string(static_cast<int>(large_arc_flag)) + " " +
-								std::to_string(static_cast<int>(sweep_flag)) + " " +
-								std::to_string(x) + " " +
-								std::to_string(y);
+						void write(std::string& out) const {
+							append_number(out, rx);
+							out += ' ';
+							append_number(out, ry);
+							out += ' ';
+							append_number(out, x_axis_rotation);
+							out += ' ';
+							append_number(out, static_cast<int>(large_arc_flag));
+							out += ' ';
+							append_number(out, static_cast<int>(sweep_flag));
+							out += ' ';
+							append_number(out, x);
+							out += ' ';
+							append_number(out, y);
+						}
+
+						std::string str() const {
+							std::string result;
+							write(result);
+							return result;
 						}
 
 					public:
@@ -415,12 +489,12 @@ namespace tobor {
 						add_coordinates(std::forward<_Rest>(others) ...);
 					}
 
-					virtual std::string str() const override {
-						return std::accumulate(coordinates.cbegin(), coordinates.cend(), std::string("a"),
-							[](const std::string& acc, const step& el) -> std::string {
-								return acc + " " + el.str();
-							}
-						);
+					virtual void write(std::string& out) const override {
+						out += 'a';
+						for (const step& el : coordinates) {
+							out += ' ';
+							el.write(out);
+						}
 					}
 
 					virtual std::shared_ptr<svg_path_element> clone() const override {
@@ -463,29 +537,24 @@ namespace tobor {
 				svg_path& operator = (svg_path&& other) = delete;
 
 
-				virtual std::string get_svg() const override {
-					auto result = std::string("<path");
-
-					result += std::string(" d=\"") +
-						std::accumulate(
-							path_elements.cbegin(),
-							path_elements.cend(),
-							std::string(""),
-							[](const std::string& acc, const std::shared_ptr<svg_path_element>& el) -> std::string {
-								return acc.empty() ?
-									el->str() :
-									acc + " " + el->str();
-							})
-						+ "\"";
-							result += std::accumulate(
-								other_properties.cbegin(),
-								other_properties.cend(),
-								std::string(""),
-								[](const std::string& acc, const map::value_type& el) -> std::string {
-									return acc + " " + el.first + "=" + "\"" + el.second + "\"";
-								});
-							result += std::string("/>");
-							return result;
+				virtual void write_svg(std::string& out) const override {
+					out += "<path d=\"";
+					const std::size_t path_data_begin{ out.size() };
+					for (const std::shared_ptr<svg_path_element>& el : path_elements) {
+						if (out.size() != path_data_begin) {
+							out += ' ';
+						}
+						el->write(out);
+					}
+					out += '"';
+					for (const map::value_type& el : other_properties) {
+						out += ' ';
+						out += el.first;
+						out += "=\"";
+						out += el.second;
+						out += '"';
+					}
+					out += "/>";
 				}
 
 				std::string& fill() {
@@ -22,6 +22,8 @@ namespace tobor {
 
 			using svg_primitive = tobor::v1_0::svg::svg_primitive;
 
+			using svg_translation = tobor::v1_0::svg::svg_translation;
+
 			using svg_path_element = tobor::v1_0::svg::svg_path_element;
 
 			namespace svg_path_elements {
@@ -580,6 +582,18 @@ namespace tobor {
 				return svg_walls;
 			}
 
+			inline static std::unique_ptr<piece_drawer<world_type>> make_piece_drawer(piece_shape_selection shape) {
+				if (shape == piece_shape_selection::BALL) {
+					return std::make_unique<ball_piece_drawer<world_type>>();
+				}
+				else if (shape == piece_shape_selection::DUCK) {
+					return std::make_unique<duck_piece_drawer<world_type>>();
+				}
+				else {
+					throw std::invalid_argument("Unknown shape in SVG draw process.");
+				}
+			}
+
 		public:
 
 
@@ -592,16 +606,7 @@ namespace tobor {
 				const coloring& c,
 				piece_shape_selection shape
 			) {
-				std::unique_ptr<piece_drawer<world_type>> piece_drawer;
-				if (shape == piece_shape_selection::BALL) {
-					piece_drawer = std::make_unique<ball_piece_drawer<world_type>>();
-				}
-				else if (shape == piece_shape_selection::DUCK) {
-					piece_drawer = std::make_unique<duck_piece_drawer<world_type>>();
-				}
-				else {
-					throw std::invalid_argument("Unknown shape in SVG draw process.");
-				}
+				std::unique_ptr<piece_drawer<world_type>> piece_drawer{ make_piece_drawer(shape) };
 
 				drawing_style_sheet dss;
 
@@ -693,6 +698,70 @@ namespace tobor {
 				return svg_root->get_svg();
 			}
 
+			/**
+			*	@brief Draws the same as draw_tobor_world() except for the pieces. This layer does not change during a game.
+			*/
+			inline static std::string draw_tobor_board(
+				const world_type& tw,
+				const cell_id_type& target_cell,
+				const std::string& target_color
+			) {
+				drawing_style_sheet dss;
+
+				auto svg_body = std::make_unique<svg::svg_compound>(
+					draw_tobor_background(tw, dss),
+					draw_blocked_cells(tw, dss),
+					fill_whole_cell(tw, dss, target_cell, target_color),
+					draw_tobor_grid(tw, dss),
+					draw_walls(tw, dss)
+				);
+
+				const std::string svg_root_height = std::to_string(dss.CELL_HEIGHT * tw.get_vertical_size() + dss.TOP_PADDING + dss.BOTTOM_PADDING);
+				const std::string svg_root_width = std::to_string(dss.CELL_WIDTH * tw.get_vertical_size() + dss.LEFT_PADDING + dss.RIGHT_PADDING);
+				auto svg_root = std::make_unique<svg::svg_environment>(svg_root_height, svg_root_width, std::make_unique<svg::xml_version>(), std::move(svg_body));
+
+				return svg_root->get_svg();
+			}
+
+			/**
+			*	@brief Draws a single piece on a canvas of one cell.
+			*
+			*	@details Placed at cell_position() on top of draw_tobor_board() it looks the same as the piece drawn by draw_tobor_world().
+			*/
+			inline static std::string draw_piece(
+				const world_type& tw,
+				const std::string& color,
+				piece_shape_selection shape
+			) {
+				drawing_style_sheet dss;
+
+				const auto north_west_cell{ cell_id_type::create_by_coordinates(0, static_cast<cell_narrow_int>(tw.get_vertical_size() - 1), tw) };
+
+				auto svg_body = std::make_unique<svg::svg_translation>(
+					-dss.LEFT_PADDING,
+					-dss.TOP_PADDING,
+					(*make_piece_drawer(shape))(tw, dss, north_west_cell, color)
+				);
+
+				const std::string svg_root_height = std::to_string(dss.CELL_HEIGHT);
+				const std::string svg_root_width = std::to_string(dss.CELL_WIDTH);
+				auto svg_root = std::make_unique<svg::svg_environment>(svg_root_height, svg_root_width, std::make_unique<svg::xml_version>(), std::move(svg_body));
+
+				return svg_root->get_svg();
+			}
+
+			/**
+			*	@brief Returns the upper left corner of \p cell in the coordinates of draw_tobor_world() and draw_tobor_board().
+			*/
+			inline static std::pair<double, double> cell_position(const world_type& tw, const cell_id_type& cell) {
+				drawing_style_sheet dss;
+
+				return std::make_pair(
+					dss.LEFT_PADDING + dss.CELL_WIDTH * cell.get_x_coord(tw),
+					dss.TOP_PADDING + dss.CELL_HEIGHT * (tw.get_vertical_size() - 1 - cell.get_y_coord(tw))
+				);
+			}
+
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "engine_typeset.h"
+#include "svg_1_1.h"
+#include "world_generator_1_1.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+*	@brief Measures rendering an original game as one full-board SVG document with draw_tobor_world().
+*/
+template<class Pieces_Quantity_T>
+class SvgBenchmark {
+public:
+
+	using pieces_quantity_type = Pieces_Quantity_T;
+
+	using engine_typeset = ClassicEngineTypeSet<pieces_quantity_type>;
+
+	using graphics_type = tobor::v1_1::tobor_graphics<typename engine_typeset::world_type, typename engine_typeset::positions_of_pieces_type_solver>;
+
+	using board_generator_type = tobor::v1_1::world_generator::original_4_of_16;
+
+	using state_generator_type = tobor::v1_1::world_generator::initial_state_generator<
+		typename engine_typeset::positions_of_pieces_type_interactive,
+		256,
+		pieces_quantity_type::COUNT_TARGET_PIECES,
+		pieces_quantity_type::COUNT_NON_TARGET_PIECES,
+		4>;
+
+	/**
+	*	@brief Measurement of one piece shape.
+	*/
+	struct result {
+		std::string name;
+		std::size_t document_bytes;
+		double seconds_per_render; // best of all repetitions
+
+		inline double renders_per_second() const noexcept { return seconds_per_render > 0 ? 1.0 / seconds_per_render : 0; }
+	};
+
+private:
+
+	static result measure(
+		const std::string& name,
+		const typename engine_typeset::world_type& world,
+		const typename engine_typeset::positions_of_pieces_type_solver& state,
+		const typename engine_typeset::cell_id_type& target_cell,
+		typename graphics_type::piece_shape_selection shape,
+		const std::size_t& repetitions,
+		const std::size_t& renders_per_repetition
+	) {
+		const typename graphics_type::coloring coloring("#f4191c", "#ffbd02", "#00a340", "#4285f4");
+
+		result r{ name, 0, std::numeric_limits<double>::max() };
+
+		for (std::size_t i{ 0 }; i < std::max<std::size_t>(repetitions, 1); ++i) {
+			std::size_t document_bytes{ 0 };
+
+			const auto start{ std::chrono::steady_clock::now() };
+			for (std::size_t j{ 0 }; j < std::max<std::size_t>(renders_per_repetition, 1); ++j) {
+				document_bytes = graphics_type::draw_tobor_world(world, state, target_cell, coloring, shape).size();
+			}
+			const std::chrono::duration<double> duration{ std::chrono::steady_clock::now() - start };
+
+			r.document_bytes = document_bytes;
+			r.seconds_per_render = std::min(r.seconds_per_render, duration.count() / static_cast<double>(std::max<std::size_t>(renders_per_repetition, 1)));
+		}
+		return r;
+	}
+
+public:
+
+	/**
+	*	@brief Renders the original game given by the generator counters \p renders_per_repetition times per repetition, with each piece shape.
+	*
+	*	@return Returns the results of the ball and the duck piece shape, in this order.
+	*/
+	static std::vector<result> run(
+		const uint64_t& world_generator_counter,
+		const uint64_t& state_generator_counter,
+		const std::size_t& repetitions,
+		const std::size_t& renders_per_repetition = 100
+	) {
+		board_generator_type board_generator(world_generator_counter);
+
+		state_generator_type state_generator;
+		state_generator.set_counter(state_generator_counter);
+
+		const auto world{ board_generator.get_tobor_world() };
+		const auto target_cell{ board_generator.get_target_cell() };
+		const auto state{ state_generator.get_positions_of_pieces(world).naked() };
+
+		return {
+			measure("ball pieces", world, state, target_cell, graphics_type::piece_shape_selection::BALL, repetitions, renders_per_repetition),
+			measure("duck pieces", world, state, target_cell, graphics_type::piece_shape_selection::DUCK, repetitions, renders_per_repetition)
+		};
+	}
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+*	@brief Fixed number of worker threads executing submitted tasks in submission order.
+*
+*	@details Tasks must not throw. The destructor finishes all queued tasks before joining the workers.
+*/
+class ThreadPool {
+
+	std::mutex _mutex;
+
+	std::condition_variable _task_available;
+
+	std::condition_variable _idle;
+
+	/** guarded by _mutex */
+	std::deque<std::function<void()>> _tasks;
+
+	/** guarded by _mutex, number of tasks being executed right now */
+	std::size_t _count_running{ 0 };
+
+	/** guarded by _mutex */
+	bool _stopping{ false };
+
+	std::vector<std::thread> _workers;
+
+	void work() {
+		while (true) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_task_available.wait(lock, [&]() { return _stopping || !_tasks.empty(); });
+				if (_tasks.empty()) {
+					return; // stopping
+				}
+				task = std::move(_tasks.front());
+				_tasks.pop_front();
+				++_count_running;
+			}
+
+			task();
+
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				--_count_running;
+				if (_tasks.empty() && _count_running == 0) {
+					_idle.notify_all();
+				}
+			}
+		}
+	}
+
+public:
+
+	/**
+	*	@brief Starts \p count_threads workers, at least one.
+	*/
+	explicit ThreadPool(std::size_t count_threads) {
+		if (count_threads == 0) {
+			count_threads = 1;
+		}
+		_workers.reserve(count_threads);
+		for (std::size_t i{ 0 }; i < count_threads; ++i) {
+			_workers.emplace_back(&ThreadPool::work, this);
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stopping = true;
+		}
+		_task_available.notify_all();
+		for (auto& worker : _workers) {
+			worker.join();
+		}
+	}
+
+	inline std::size_t size() const noexcept { return _workers.size(); }
+
+	void submit(std::function<void()> task) {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_tasks.push_back(std::move(task));
+		}
+		_task_available.notify_one();
+	}
+
+	/**
+	*	@brief Blocks until there are neither queued nor running tasks.
+	*/
+	void wait() {
+		std::unique_lock<std::mutex> lock(_mutex);
+		_idle.wait(lock, [&]() { return _tasks.empty() && _count_running == 0; });
+	}
+};
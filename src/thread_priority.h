@@ -0,0 +1,34 @@
+#pragma once
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#elif defined(__linux__)
+	#include <sys/resource.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#else
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+/**
+*	@brief Lowers the scheduling priority of the calling thread, for background work which must not slow down the user interface.
+*
+*	@details Best effort, failures are ignored.
+*/
+inline void lower_current_thread_priority() noexcept {
+#ifdef _WIN32
+	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#elif defined(__linux__)
+	// the nice value is an attribute of each thread on Linux:
+	static constexpr int BACKGROUND_NICE_VALUE{ 10 };
+	setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), BACKGROUND_NICE_VALUE);
+#else
+	sched_param param{};
+	param.sched_priority = sched_get_priority_min(SCHED_OTHER);
+	pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+#endif
+}
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace tobor {
+	namespace trace {
+
+		/**
+		*	@brief Returns true if and only if trace points are compiled in, see TOBOR_TRACE_ENABLE.
+		*/
+		inline constexpr bool enabled() noexcept {
+#ifdef TOBOR_TRACE_ENABLE
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		/**
+		*	@brief A recorded trace event. \p name must be a string literal.
+		*/
+		struct event {
+			const char* name;
+			uint64_t timestamp_ns;
+			int64_t value;
+			char phase; // 'B' begin of span, 'E' end of span, 'C' counter
+		};
+
+		/**
+		*	@brief Ring buffer of the most recent events of one thread.
+		*
+		*	@details Single producer: only the owning thread records. Each slot is guarded by a sequence number (seqlock),
+		*		so readers on other threads may export while the owner keeps recording. Readers drop slots which were being overwritten while reading.
+		*		The index of recorded events never decreases. Clearing only moves the first index to export, so any thread may clear.
+		*/
+		class thread_buffer {
+		public:
+
+			static constexpr std::size_t CAPACITY{ 1 << 16 };
+
+		private:
+
+			/**
+			*	@brief Storage of one event. \p sequence is 2 * index + 1 while the event of that index is written, and 2 * index + 2 once it is complete.
+			*/
+			struct slot {
+				std::atomic<uint64_t> sequence;
+				std::atomic<const char*> name;
+				std::atomic<uint64_t> timestamp_ns;
+				std::atomic<int64_t> value;
+				std::atomic<char> phase;
+			};
+
+			std::array<slot, CAPACITY> _slots;
+
+			std::atomic<uint64_t> _count_recorded{ 0 };
+
+			std::atomic<uint64_t> _count_cleared{ 0 }; // events of smaller index are not exported
+
+			const uint32_t _thread_index;
+
+		public:
+
+			explicit thread_buffer(uint32_t thread_index) : _slots(), _thread_index(thread_index) {}
+
+			inline uint32_t thread_index() const noexcept { return _thread_index; }
+
+			inline void record(const char* name, char phase, int64_t value = 0) noexcept {
+				const uint64_t index{ _count_recorded.load(std::memory_order_relaxed) };
+				const uint64_t timestamp_ns{
+					static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count())
+				};
+				slot& s{ _slots[index % CAPACITY] };
+
+				s.sequence.store(2 * index + 1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+				s.name.store(name, std::memory_order_relaxed);
+				s.timestamp_ns.store(timestamp_ns, std::memory_order_relaxed);
+				s.value.store(value, std::memory_order_relaxed);
+				s.phase.store(phase, std::memory_order_relaxed);
+				s.sequence.store(2 * index + 2, std::memory_order_release);
+
+				_count_recorded.store(index + 1, std::memory_order_release);
+			}
+
+			/**
+			*	@brief Appends the buffered events to \p destination, oldest first.
+			*/
+			void copy_events(std::vector<event>& destination) const {
+				const uint64_t end{ _count_recorded.load(std::memory_order_acquire) };
+				const uint64_t cleared{ std::min(_count_cleared.load(std::memory_order_acquire), end) };
+				const uint64_t begin{ std::max(end > CAPACITY ? end - CAPACITY : 0, cleared) };
+
+				destination.reserve(destination.size() + static_cast<std::size_t>(end - begin));
+				for (uint64_t i{ begin }; i < end; ++i) {
+					const slot& s{ _slots[i % CAPACITY] };
+
+					const uint64_t sequence_before{ s.sequence.load(std::memory_order_acquire) };
+					const event e{
+						s.name.load(std::memory_order_relaxed),
+						s.timestamp_ns.load(std::memory_order_relaxed),
+						s.value.load(std::memory_order_relaxed),
+						s.phase.load(std::memory_order_relaxed)
+					};
+					std::atomic_thread_fence(std::memory_order_acquire);
+					const uint64_t sequence_after{ s.sequence.load(std::memory_order_relaxed) };
+
+					// skip slots which are overwritten by newer events meanwhile:
+					if (sequence_before == 2 * i + 2 && sequence_after == sequence_before) {
+						destination.push_back(e);
+					}
+				}
+			}
+
+			/**
+			*	@brief Drops all events recorded so far. Events recorded concurrently may or may not be dropped.
+			*/
+			inline void clear() noexcept {
+				const uint64_t recorded{ _count_recorded.load(std::memory_order_acquire) };
+				uint64_t cleared{ _count_cleared.load(std::memory_order_relaxed) };
+				while (cleared < recorded && !_count_cleared.compare_exchange_weak(cleared, recorded, std::memory_order_release, std::memory_order_relaxed)) {}
+			}
+		};
+
+		/**
+		*	@brief Process-wide list of all thread buffers.
+		*
+		*	@details When a thread exits, the events of its buffer are flushed into a list of finished events, which keeps the most recent
+		*		MAX_FINISHED_EVENTS events, and the buffer is recycled for the next new thread. So the number of buffers is bounded by the
+		*		maximum number of threads recording at the same time.
+		*/
+		class registry {
+		public:
+
+			static constexpr std::size_t MAX_FINISHED_EVENTS{ thread_buffer::CAPACITY };
+
+		private:
+
+			/**
+			*	@brief Holds the buffer of one thread and returns it to the registry when the thread exits.
+			*/
+			class buffer_owner {
+				std::shared_ptr<thread_buffer> _buffer;
+
+			public:
+
+				buffer_owner() : _buffer(instance().acquire_buffer()) {}
+
+				buffer_owner(const buffer_owner&) = delete;
+
+				buffer_owner& operator=(const buffer_owner&) = delete;
+
+				~buffer_owner() { instance().release_buffer(_buffer); }
+
+				inline thread_buffer& buffer() const noexcept { return *_buffer; }
+			};
+
+			struct finished_event {
+				uint32_t thread_index;
+				event e;
+			};
+
+			std::mutex _mutex;
+
+			std::vector<std::shared_ptr<thread_buffer>> _buffers; // in use by threads
+
+			std::vector<std::shared_ptr<thread_buffer>> _free_buffers;
+
+			std::deque<finished_event> _finished_events; // of exited threads, oldest first
+
+			registry() {}
+
+			std::shared_ptr<thread_buffer> acquire_buffer() {
+				std::lock_guard<std::mutex> lock(_mutex);
+				std::shared_ptr<thread_buffer> buffer;
+				if (_free_buffers.empty()) {
+					buffer = std::make_shared<thread_buffer>(static_cast<uint32_t>(_buffers.size() + 1));
+				}
+				else {
+					buffer = std::move(_free_buffers.back());
+					_free_buffers.pop_back();
+				}
+				_buffers.push_back(buffer);
+				return buffer;
+			}
+
+			void release_buffer(const std::shared_ptr<thread_buffer>& buffer) {
+				std::vector<event> events;
+
+				std::lock_guard<std::mutex> lock(_mutex);
+				buffer->copy_events(events);
+				buffer->clear();
+				for (const auto& e : events) {
+					_finished_events.push_back(finished_event{ buffer->thread_index(), e });
+				}
+				while (_finished_events.size() > MAX_FINISHED_EVENTS) {
+					_finished_events.pop_front();
+				}
+				_buffers.erase(std::find(_buffers.begin(), _buffers.end(), buffer));
+				_free_buffers.push_back(buffer);
+			}
+
+		public:
+
+			registry(const registry&) = delete;
+
+			registry& operator=(const registry&) = delete;
+
+			inline static registry& instance() {
+				static registry r;
+				return r;
+			}
+
+			/**
+			*	@brief Returns the buffer of the calling thread, acquiring it on first use.
+			*/
+			inline static thread_buffer& local_buffer() {
+				thread_local buffer_owner owner;
+				return owner.buffer();
+			}
+
+			/**
+			*	@brief Returns the number of buffers allocated, in use or free.
+			*/
+			std::size_t count_buffers() {
+				std::lock_guard<std::mutex> lock(_mutex);
+				return _buffers.size() + _free_buffers.size();
+			}
+
+			void clear() {
+				std::lock_guard<std::mutex> lock(_mutex);
+				for (const auto& buffer : _buffers) {
+					buffer->clear();
+				}
+				_finished_events.clear();
+			}
+
+			/**
+			*	@brief Writes all buffered events in Chrome trace event format, to be loaded into chrome://tracing or Perfetto.
+			*/
+			void write_chrome_trace(std::ostream& out) {
+				std::vector<finished_event> all_events;
+				{
+					// keeps threads from flushing their buffers meanwhile, recording continues
+					std::lock_guard<std::mutex> lock(_mutex);
+					all_events.assign(_finished_events.cbegin(), _finished_events.cend());
+
+					std::vector<event> events;
+					for (const auto& buffer : _buffers) {
+						events.clear();
+						buffer->copy_events(events);
+						for (const auto& e : events) {
+							all_events.push_back(finished_event{ buffer->thread_index(), e });
+						}
+					}
+				}
+
+				out << "{\"traceEvents\":[";
+				bool first{ true };
+				for (const auto& [thread_index, e] : all_events) {
+					if (!first) out << ",";
+					first = false;
+					out << "\n{\"name\":\"" << e.name << "\",\"ph\":\"" << e.phase
+						<< "\",\"ts\":" << e.timestamp_ns / 1000 << "." << (e.timestamp_ns % 1000) / 100 << (e.timestamp_ns % 100) / 10 << e.timestamp_ns % 10
+						<< ",\"pid\":1,\"tid\":" << thread_index;
+					if (e.phase == 'C') {
+						out << ",\"args\":{\"value\":" << e.value << "}";
+					}
+					out << "}";
+				}
+				out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+			}
+
+			/**
+			*	@brief Writes the Chrome trace to the file at \p path. Returns false if the file cannot be written.
+			*/
+			bool write_chrome_trace(const std::string& path) {
+				std::ofstream file(path, std::ios::binary);
+				if (!file) return false;
+				write_chrome_trace(file);
+				return static_cast<bool>(file);
+			}
+		};
+
+		/**
+		*	@brief Records a span from construction to destruction.
+		*/
+		class scoped_span {
+			const char* _name;
+
+		public:
+
+			explicit scoped_span(const char* name) : _name(name) { registry::local_buffer().record(_name, 'B'); }
+
+			scoped_span(const scoped_span&) = delete;
+
+			scoped_span& operator=(const scoped_span&) = delete;
+
+			~scoped_span() { registry::local_buffer().record(_name, 'E'); }
+		};
+
+	}
+}
+
+#define TOBOR_TRACE_CONCAT_IMPL(a, b) a##b
+#define TOBOR_TRACE_CONCAT(a, b) TOBOR_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef TOBOR_TRACE_ENABLE
+
+/** Records a span named \p name (a string literal) until the end of the enclosing scope. */
+#define TOBOR_TRACE_SCOPE(name) const ::tobor::trace::scoped_span TOBOR_TRACE_CONCAT(tobor_trace_span_, __LINE__)(name)
+
+/** Records the counter \p name (a string literal) with value \p value. */
+#define TOBOR_TRACE_COUNTER(name, value) ::tobor::trace::registry::local_buffer().record(name, 'C', static_cast<int64_t>(value))
+
+#else
+
+#define TOBOR_TRACE_SCOPE(name) static_cast<void>(0)
+
+#define TOBOR_TRACE_COUNTER(name, value) static_cast<void>(0)
+
+#endif // TOBOR_TRACE_ENABLE
@@ -351,13 +351,14 @@ void tobor::v1_1::world_generator::original_4_of_16::create_quadrants(std::array
 
 tobor::v1_1::world_generator::original_4_of_16::world_type
 tobor::v1_1::world_generator::original_4_of_16::get_quadrant(std::size_t planet_color, std::size_t quadrant_index) {
-	static std::optional<std::array<std::vector<world_type>, 4>> quadrants;
-
-	if (!quadrants.has_value()) {
-		quadrants.emplace();
-		create_quadrants(quadrants.value());
-	}
-	return quadrants.value()[planet_color][quadrant_index];
+	// thread-safe initialization on first call:
+	static const std::array<std::vector<world_type>, 4> quadrants = []() {
+		std::array<std::vector<world_type>, 4> result;
+		create_quadrants(result);
+		return result;
+		}();
+
+	return quadrants[planet_color][quadrant_index];
 }
 
 void tobor::v1_1::world_generator::original_4_of_16::copy_walls_turned(const world_type& source, uint8_t rotation, world_type& destination) {
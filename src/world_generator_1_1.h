@@ -12,6 +12,10 @@
 #include <array>
 #include <optional>
 #include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <utility>
 
 namespace tobor {
 
@@ -280,6 +284,14 @@ namespace tobor {
 				}
 
 
+				/**
+				*	@brief Selects the target cell from \p target_cells, which must contain the target cells of get_tobor_world() in the order of get_target_cell_id_vector().
+				*/
+				cell_id_type get_target_cell(const std::vector<cell_id_type>& target_cells) const {
+					auto [select_aligned_world, rotation, select_target] = split_element();
+					return target_cells[select_target % target_cells.size()];
+				}
+
 				cell_id_type get_target_cell() const {
 					auto w = get_tobor_world();
 					const std::vector<cell_id_type::int_cell_id_type> cell_ids{ get_target_cell_id_vector(w) };
@@ -658,6 +670,163 @@ namespace tobor {
 
 			};
 
+			/**
+			*	@brief Generates random 16 x 16 worlds following the conventions of original_4_of_16:
+			*	2 x 2 blocked center cells, two walls at the outer border per quadrant and target cells with walls at two adjacent sides.
+			*
+			*	@details Target cells are distributed evenly over the quadrants, none at the border or next to the center.
+			*	Only worlds where original_4_of_16::get_target_cell_id_vector() recognizes exactly count_target_cells() targets are returned,
+			*	all others are rejected and generated again.
+			*/
+			class random_world_generator {
+			public:
+
+				using world_type = original_4_of_16::world_type;
+
+				using cell_id_type = original_4_of_16::cell_id_type;
+
+				static constexpr uint8_t SIZE{ 16 };
+
+				static constexpr uint8_t HALF_SIZE{ SIZE / 2 };
+
+				static constexpr std::size_t MAX_TARGET_CELLS_PER_QUADRANT{ 8 };
+
+			private:
+
+				static constexpr std::size_t MAX_PLACEMENT_ATTEMPTS{ 100 };
+
+				std::size_t _count_target_cells;
+
+				/**
+				*	@brief Checks whether a target cell may be placed at (\p x, \p y): not at the border, not in or next to the blocked center.
+				*/
+				inline static bool is_target_candidate(const uint8_t& x, const uint8_t& y) {
+					if (x == 0 || y == 0 || x == SIZE - 1 || y == SIZE - 1)
+						return false;
+					const bool x_central{ HALF_SIZE - 2 <= x && x <= HALF_SIZE + 1 };
+					const bool y_central{ HALF_SIZE - 2 <= y && y <= HALF_SIZE + 1 };
+					return !(x_central && y_central);
+				}
+
+				/**
+				*	@brief Places the target cells of one quadrant. Returns false if there was no space left for a target cell.
+				*/
+				template<class Random_Engine_T>
+				static bool place_target_cells(
+					world_type& world,
+					std::vector<std::pair<uint8_t, uint8_t>>& placed,
+					const uint8_t& quadrant,
+					const std::size_t& count,
+					Random_Engine_T& engine
+				) {
+					const uint8_t x_offset = quadrant % 2 ? HALF_SIZE : 0;
+					const uint8_t y_offset = quadrant / 2 ? HALF_SIZE : 0;
+
+					std::uniform_int_distribution<int> coordinate(0, HALF_SIZE - 1);
+					std::uniform_int_distribution<int> orientation(0, 3);
+
+					for (std::size_t i{ 0 }; i < count; ++i) {
+						std::size_t attempts{ 0 };
+						uint8_t x;
+						uint8_t y;
+						while (true) {
+							if (++attempts > MAX_PLACEMENT_ATTEMPTS)
+								return false;
+							x = static_cast<uint8_t>(x_offset + coordinate(engine));
+							y = static_cast<uint8_t>(y_offset + coordinate(engine));
+							if (!is_target_candidate(x, y))
+								continue;
+							const bool too_close = std::any_of(placed.cbegin(), placed.cend(), [&](const auto& other) {
+								return std::abs(int(other.first) - int(x)) < 2 && std::abs(int(other.second) - int(y)) < 2;
+								});
+							if (!too_close)
+								break;
+						}
+						placed.emplace_back(x, y);
+
+						const auto id{ world.coordinates_to_cell_id(x, y) };
+						const auto transposed_id{ world.coordinates_to_transposed_cell_id(x, y) };
+						const int o{ orientation(engine) };
+						if (o & 1) {
+							world.east_wall_by_id(id) = true;
+						}
+						else {
+							world.west_wall_by_id(id) = true;
+						}
+						if (o & 2) {
+							world.north_wall_by_transposed_id(transposed_id) = true;
+						}
+						else {
+							world.south_wall_by_transposed_id(transposed_id) = true;
+						}
+					}
+					return true;
+				}
+
+			public:
+
+				/**
+				*	@brief Throws std::invalid_argument if \p count_target_cells does not fit on the board.
+				*/
+				random_world_generator(const std::size_t& count_target_cells = original_4_of_16::COUNT_TARGET_CELLS) : _count_target_cells(count_target_cells) {
+					if (count_target_cells > 4 * MAX_TARGET_CELLS_PER_QUADRANT) {
+						throw std::invalid_argument("random_world_generator: too many target cells");
+					}
+				}
+
+				inline std::size_t count_target_cells() const noexcept { return _count_target_cells; }
+
+				/**
+				*	@brief Returns a random world, using \p engine as the only source of randomness.
+				*/
+				template<class Random_Engine_T>
+				world_type operator()(Random_Engine_T& engine) const {
+					std::uniform_int_distribution<int> border_distance(2, HALF_SIZE - 2);
+					std::uniform_int_distribution<int> flip(0, 1);
+
+					while (true) {
+						world_type world(SIZE, SIZE);
+						world.block_center_cells(2, 2);
+
+						// two walls at the outer border per quadrant:
+						for (uint8_t quadrant{ 0 }; quadrant < 4; ++quadrant) {
+							const bool east_half{ quadrant % 2 == 1 };
+							const bool north_half{ quadrant / 2 == 1 };
+
+							const int x{ east_half ? SIZE - border_distance(engine) : border_distance(engine) };
+							const uint8_t y_border = north_half ? SIZE - 1 : 0;
+							world.west_wall_by_id(world.coordinates_to_cell_id(static_cast<uint8_t>(x), y_border)) = true;
+
+							const int y{ north_half ? SIZE - border_distance(engine) : border_distance(engine) };
+							const uint8_t x_border = east_half ? SIZE - 1 : 0;
+							world.south_wall_by_transposed_id(world.coordinates_to_transposed_cell_id(x_border, static_cast<uint8_t>(y))) = true;
+						}
+
+						// target cells, evenly distributed over the quadrants:
+						std::array<std::size_t, 4> counts;
+						counts.fill(_count_target_cells / 4);
+						std::array<uint8_t, 4> quadrants{ 0, 1, 2, 3 };
+						std::shuffle(quadrants.begin(), quadrants.end(), engine);
+						for (std::size_t i{ 0 }; i < _count_target_cells % 4; ++i) {
+							++counts[quadrants[i]];
+						}
+
+						std::vector<std::pair<uint8_t, uint8_t>> placed;
+						placed.reserve(_count_target_cells);
+
+						bool success{ true };
+						for (uint8_t quadrant{ 0 }; quadrant < 4 && success; ++quadrant) {
+							success = place_target_cells(world, placed, quadrant, counts[quadrant], engine);
+						}
+
+						if (success && original_4_of_16::get_target_cell_id_vector(world).size() == _count_target_cells) {
+							return world;
+						}
+					}
+				}
+
+			};
+
 			class dynamic_generator {
 				// select a generator, an input, give generated board as output.
 			};
@@ -6,6 +6,7 @@
 #include "../src/models/augmented_positions_of_pieces.h"
 #include "../src/models/piece_id.h"
 #include "../src/models/piece_move.h"
+#include "../src/models/move_path.h"
 
 
 namespace tobor {
@@ -26,6 +27,8 @@ namespace tobor {
 
 		using default_piece_move = piece_move<default_piece_id>;
 
+		using default_move_path = move_path<default_piece_move>;
+
 	}
 }
 
@@ -0,0 +1,41 @@
+#include "gtest/gtest.h"
+
+#include "../src/board_registry.h"
+
+#include "../src/models/pieces_quantity.h"
+
+using registry_pieces_quantity = tobor::v1_1::pieces_quantity<uint8_t, 1, 3>;
+
+using registry_type = BoardRegistry<registry_pieces_quantity>;
+
+TEST(board_registry, equal_worlds_share_one_board) {
+	auto world = registry_type::world_type(16, 16);
+	world.block_center_cells(2, 2);
+
+	auto copy = world;
+
+	const auto board = registry_type::instance().get(world);
+	const auto same_board = registry_type::instance().get(copy);
+
+	EXPECT_EQ(board, same_board);
+	EXPECT_EQ(board->world().wall_hash(), copy.wall_hash());
+
+	copy.west_wall_by_id(17) = true;
+
+	const auto other_board = registry_type::instance().get(copy);
+
+	EXPECT_NE(board, other_board);
+	EXPECT_TRUE(other_board->world() == copy);
+	EXPECT_FALSE(other_board->world() == world);
+}
+
+TEST(board_registry, releases_unused_boards) {
+	auto world = registry_type::world_type(8, 8);
+
+	const std::size_t size_before{ registry_type::instance().size() };
+	{
+		const auto board = registry_type::instance().get(world);
+		EXPECT_EQ(registry_type::instance().size(), size_before + 1);
+	}
+	EXPECT_EQ(registry_type::instance().size(), size_before);
+}
@@ -0,0 +1,133 @@
+#include "gtest/gtest.h"
+
+#include "../src/board_rotation.h"
+#include "../src/solver_daemon.h"
+
+#include "../src/models/pieces_quantity.h"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <set>
+#include <string>
+
+using rotation_pieces_quantity = tobor::v1_1::pieces_quantity<uint8_t, 1, 3>;
+
+using board_rotation_type = BoardRotation<rotation_pieces_quantity>;
+
+TEST(board_rotation, generator_rotations_are_turned_worlds) {
+	using generator_type = tobor::v1_1::world_generator::original_4_of_16;
+
+	for (uint64_t aligned_world : { 0, 17, 555, 1535 }) {
+		const auto world{ generator_type::get_world(aligned_world, 0) };
+		for (uint8_t rotation{ 0 }; rotation < board_rotation_type::COUNT_ROTATIONS; ++rotation) {
+			EXPECT_TRUE(board_rotation_type::turned_world(world, rotation) == generator_type::get_world(aligned_world, rotation));
+		}
+	}
+}
+
+TEST(board_rotation, all_rotations_have_one_canonical_game) {
+	using cell_id_type = board_rotation_type::cell_id_type;
+
+	const auto world{ tobor::v1_1::world_generator::original_4_of_16::get_world(42, 0) };
+
+	const board_rotation_type::positions_of_pieces_type_solver initial_state(
+		{ cell_id_type::create_by_coordinates(1, 2, world) },
+		{ cell_id_type::create_by_coordinates(15, 0, world), cell_id_type::create_by_coordinates(3, 14, world), cell_id_type::create_by_coordinates(9, 9, world) }
+	);
+
+	std::set<uint64_t> canonical_hashes;
+	for (uint8_t rotation{ 0 }; rotation < board_rotation_type::COUNT_ROTATIONS; ++rotation) {
+		const auto world_turned{ board_rotation_type::turned_world(world, rotation) };
+		const auto state_turned{ board_rotation_type::turned_state(initial_state, world, rotation) };
+
+		const uint8_t canonical{ board_rotation_type::canonical_rotation(world_turned, state_turned) };
+
+		const auto canonical_world{ board_rotation_type::turned_world(world_turned, canonical) };
+		canonical_hashes.insert(canonical_world.wall_hash());
+		EXPECT_TRUE(canonical_world == board_rotation_type::turned_world(world, rotation + canonical));
+		EXPECT_EQ(board_rotation_type::turned_state(state_turned, world_turned, canonical), board_rotation_type::turned_state(initial_state, world, rotation + canonical));
+	}
+	EXPECT_EQ(canonical_hashes.size(), 1);
+
+	for (auto d = tobor::v1_1::direction::begin(); d != tobor::v1_1::direction::end(); ++d) {
+		EXPECT_EQ(board_rotation_type::turned_direction(board_rotation_type::turned_direction(d, 3), board_rotation_type::inverse_rotation(3)), d);
+	}
+}
+
+TEST(board_rotation, solver_session_maps_solutions_back) {
+	using session_type = SolverSession<rotation_pieces_quantity>;
+	using cell_id_type = session_type::cell_id_type;
+
+	const auto world{ tobor::v1_1::world_generator::original_4_of_16::get_world(42, 0) };
+	const std::array<cell_id_type, 4> pieces{
+		cell_id_type::create_by_coordinates(0, 0, world),
+		cell_id_type::create_by_coordinates(15, 0, world),
+		cell_id_type::create_by_coordinates(0, 15, world),
+		cell_id_type::create_by_coordinates(15, 15, world)
+	};
+
+	// a target reachable in a few moves:
+	cell_id_type target_cell{ pieces[0] };
+	{
+		const auto board{ BoardRegistry<rotation_pieces_quantity>::instance().get(world) };
+		const session_type::positions_of_pieces_type_solver state(pieces.cbegin());
+		for (const auto& dir : { tobor::v1_1::direction::EAST(), tobor::v1_1::direction::NORTH(), tobor::v1_1::direction::WEST(), tobor::v1_1::direction::SOUTH() }) {
+			target_cell = board->move_engine().next_cell_max_move(target_cell, state, dir);
+		}
+	}
+
+	session_type session;
+
+	std::set<std::size_t> optimal_lengths;
+	for (uint8_t rotation{ 0 }; rotation < board_rotation_type::COUNT_ROTATIONS; ++rotation) {
+		const auto world_turned{ board_rotation_type::turned_world(world, rotation) };
+
+		auto coordinates = [&](const cell_id_type& cell) {
+			const auto turned{ board_rotation_type::turned_cell(cell, world, rotation) };
+			return nlohmann::json::array({ turned.get_x_coord(world_turned), turned.get_y_coord(world_turned) });
+			};
+
+		nlohmann::json world_json{ { "width", 16 }, { "height", 16 }, { "blocked_center", { 2, 2 } } };
+		world_json["west_walls"] = nlohmann::json::array();
+		world_json["south_walls"] = nlohmann::json::array();
+		for (typename cell_id_type::int_size_type i{ 0 }; i < world_turned.count_cells(); ++i) {
+			const auto id{ static_cast<typename cell_id_type::int_cell_id_type>(i) };
+			const auto cell{ cell_id_type::create_by_id(id, world_turned) };
+			const nlohmann::json xy = nlohmann::json::array({ cell.get_x_coord(world_turned), cell.get_y_coord(world_turned) });
+			if (world_turned.west_wall_by_id(id)) world_json["west_walls"].push_back(xy);
+			if (world_turned.south_wall_by_transposed_id(cell.get_transposed_id(world_turned))) world_json["south_walls"].push_back(xy);
+		}
+
+		nlohmann::json request;
+		request["world"] = world_json;
+		request["initial_state"]["target_pieces"] = nlohmann::json::array({ coordinates(pieces[0]) });
+		request["initial_state"]["non_target_pieces"] = nlohmann::json::array({ coordinates(pieces[1]), coordinates(pieces[2]), coordinates(pieces[3]) });
+		request["target"] = coordinates(target_cell);
+
+		const nlohmann::json response = session.solve(request);
+		ASSERT_EQ(response.at("status"), "ok");
+		optimal_lengths.insert(response.at("optimal_length").get<std::size_t>());
+
+		// replay each solution on the turned world:
+		const auto board{ BoardRegistry<rotation_pieces_quantity>::instance().get(world_turned) };
+		for (const auto& moves : response.at("solutions")) {
+			std::array<cell_id_type, 4> cells{ board_rotation_type::turned_cells(pieces, world, rotation) };
+			for (const auto& move : moves) {
+				const session_type::positions_of_pieces_type_solver state(cells.cbegin());
+				const char d{ move.at("direction").get<std::string>().at(0) };
+				const auto dir{
+					d == 'N' ? tobor::v1_1::direction::NORTH() :
+					d == 'E' ? tobor::v1_1::direction::EAST() :
+					d == 'S' ? tobor::v1_1::direction::SOUTH() : tobor::v1_1::direction::WEST()
+				};
+				auto& cell{ cells[move.at("piece").get<std::size_t>()] };
+				const auto next{ board->move_engine().next_cell_max_move(cell, state, dir) };
+				EXPECT_NE(next, cell);
+				cell = next;
+			}
+			EXPECT_EQ(cells[0], board_rotation_type::turned_cell(target_cell, world, rotation));
+		}
+	}
+	EXPECT_EQ(optimal_lengths.size(), 1);
+}
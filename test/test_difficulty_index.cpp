@@ -0,0 +1,45 @@
+#include "gtest/gtest.h"
+
+#include "../src/difficulty_index.h"
+
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+TEST(difficulty_index, write_and_map) {
+	const std::string path{ "test_difficulty_index.tdi" };
+
+	using game = DifficultyIndex::game;
+
+	const std::vector<game> games{ { 7, 70 }, { 3, 30 }, { 5, 50 }, { 9, 90 }, { 1, 10 } };
+	const std::vector<std::size_t> optimal_lengths{ 4, 2, 4, std::numeric_limits<std::size_t>::max(), 0 };
+
+	DifficultyIndex::write(path, 1, 3, games, optimal_lengths);
+
+	{
+		const DifficultyIndex index(path);
+
+		EXPECT_EQ(index.count_target_pieces(), 1);
+		EXPECT_EQ(index.count_non_target_pieces(), 3);
+		EXPECT_EQ(index.count_lengths(), 5);
+		EXPECT_EQ(index.count_games(), 4);
+
+		EXPECT_EQ(index.count_games(0), 1);
+		EXPECT_EQ(index.count_games(1), 0);
+		EXPECT_EQ(index.count_games(2), 1);
+		EXPECT_EQ(index.count_games(4), 2);
+		EXPECT_EQ(index.count_games(5), 0);
+
+		EXPECT_EQ(index.get(2, 0).world_generator_counter, 3);
+		EXPECT_EQ(index.get(2, 0).state_generator_counter, 30);
+		EXPECT_EQ(index.get(4, 0).world_generator_counter, 7);
+		EXPECT_EQ(index.get(4, 1).state_generator_counter, 50);
+
+		EXPECT_EQ(index.nearest_length(1), 0);
+		EXPECT_EQ(index.nearest_length(3), 2);
+		EXPECT_EQ(index.nearest_length(20), 4);
+	}
+
+	std::remove(path.c_str());
+}
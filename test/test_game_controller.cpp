@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+
+#include "../src/game_controller.h"
+
+#include "../src/models/pieces_quantity.h"
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+
+using controller_pieces_quantity = tobor::v1_1::pieces_quantity<uint8_t, 1, 3>;
+
+using controller_type = DRWGameController<controller_pieces_quantity>;
+
+TEST(game_controller, move_does_not_wait_for_background_extraction) {
+	const auto board{ BoardRegistry<controller_pieces_quantity>::instance().get(tobor::v1_1::world_generator::original_4_of_16().get_tobor_world()) };
+	const auto& world{ board->world() };
+
+	using cell_id_type = controller_type::cell_id_type;
+
+	const controller_type::positions_of_pieces_type_interactive initial_state(
+		{ cell_id_type::create_by_coordinates(0, 0, world) },
+		{
+			cell_id_type::create_by_coordinates(15, 0, world),
+			cell_id_type::create_by_coordinates(0, 15, world),
+			cell_id_type::create_by_coordinates(15, 15, world)
+		}
+	);
+
+	static constexpr auto EXTRACTION_DURATION{ std::chrono::milliseconds(2000) };
+
+	std::promise<void> extraction_started;
+	std::future<void> extraction_started_future{ extraction_started.get_future() };
+	bool extraction_reported{ false }; // only accessed by the background thread
+
+	controller_type controller(board, initial_state, board->target_cells().front());
+
+	// simulates a long extraction:
+	controller.start_background_solver([&](const std::string& status) {
+		if (status == "Extracting solution state graph..." && !extraction_reported) {
+			extraction_reported = true;
+			extraction_started.set_value();
+			std::this_thread::sleep_for(EXTRACTION_DURATION);
+		}
+	});
+
+	ASSERT_EQ(extraction_started_future.wait_for(std::chrono::seconds(60)), std::future_status::ready);
+
+	const auto start{ std::chrono::steady_clock::now() };
+	const uint8_t moved{ controller.move_selected(tobor::v1_0::direction::EAST()) };
+	const auto duration{ std::chrono::steady_clock::now() - start };
+
+	ASSERT_EQ(moved, 0);
+	EXPECT_LT(duration, EXTRACTION_DURATION / 4);
+}
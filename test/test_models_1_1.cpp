@@ -2,3 +2,431 @@
 
 #include "default_models_1_1.h"
 
+#include "../src/engine/move_engine.h"
+#include "../src/engine/quick_move_cache.h"
+#include "../src/models/compact_state_path.h"
+#include "../src/models/simple_state_digraph.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory_resource>
+#include <set>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+	using tobor::v1_1::default_move_path;
+	using tobor::v1_1::default_piece_move;
+	using tobor::v1_1::default_piece_id;
+	using tobor::v1_1::direction;
+
+	default_move_path make_path(const std::vector<default_piece_move>& moves) {
+		default_move_path result;
+		result.vector() = moves;
+		return result;
+	}
+
+	std::vector<std::vector<default_move_path>> normalized(std::vector<std::vector<default_move_path>> partitioning) {
+		for (auto& equivalence_class : partitioning) {
+			std::sort(equivalence_class.begin(), equivalence_class.end());
+		}
+		std::sort(partitioning.begin(), partitioning.end());
+		return partitioning;
+	}
+
+}
+
+TEST(tobor__v1_1__move_path, foata_normal_form_of_interleavings) {
+	const auto a_north = default_piece_move(default_piece_id(0), direction::NORTH());
+	const auto a_east = default_piece_move(default_piece_id(0), direction::EAST());
+	const auto b_south = default_piece_move(default_piece_id(1), direction::SOUTH());
+	const auto d_west = default_piece_move(default_piece_id(3), direction::WEST());
+
+	const auto expected = make_path({ a_north, b_south, d_west, a_east });
+
+	EXPECT_EQ(make_path({ a_north, a_east, b_south, d_west }).foata_normal_form(), expected);
+	EXPECT_EQ(make_path({ d_west, b_south, a_north, a_east }).foata_normal_form(), expected);
+	EXPECT_EQ(make_path({ b_south, a_north, d_west, a_east }).foata_normal_form(), expected);
+
+	// moves of the same piece do not commute
+	EXPECT_FALSE(make_path({ a_east, a_north, b_south, d_west }).foata_normal_form() == expected);
+
+	EXPECT_EQ(default_move_path().foata_normal_form(), default_move_path());
+}
+
+TEST(tobor__v1_1__move_path, interleaving_partitioning_by_normal_form_matches_improved) {
+	const auto a_north = default_piece_move(default_piece_id(0), direction::NORTH());
+	const auto a_west = default_piece_move(default_piece_id(0), direction::WEST());
+	const auto b_south = default_piece_move(default_piece_id(1), direction::SOUTH());
+	const auto c_east = default_piece_move(default_piece_id(2), direction::EAST());
+	const auto c_west = default_piece_move(default_piece_id(2), direction::WEST());
+
+	// paths closed under swapping adjacent moves of different pieces
+	std::vector<default_move_path> paths{
+		// class 1: interleavings of a_north a_west and b_south
+		make_path({ a_north, a_west, b_south }),
+		make_path({ a_north, b_south, a_west }),
+		make_path({ b_south, a_north, a_west }),
+		// class 2: interleavings of c_east and b_south
+		make_path({ c_east, b_south }),
+		make_path({ b_south, c_east }),
+		// class 3: single representative
+		make_path({ c_west, c_east }),
+		// class 4: a_north and c_west
+		make_path({ c_west, a_north }),
+		make_path({ a_north, c_west })
+	};
+
+	const auto by_normal_form = normalized(default_move_path::interleaving_partitioning_by_normal_form(paths));
+	const auto improved = normalized(default_move_path::interleaving_partitioning_improved(paths));
+
+	EXPECT_EQ(by_normal_form.size(), 4);
+	EXPECT_EQ(by_normal_form, improved);
+	EXPECT_EQ(normalized(default_move_path::interleaving_partitioning(paths)), improved);
+}
+
+TEST(tobor__v1_1__move_path, interleaving_partitioning_differs_from_normal_form) {
+	const auto a_north = default_piece_move(default_piece_id(0), direction::NORTH());
+	const auto a_west = default_piece_move(default_piece_id(0), direction::WEST());
+	const auto b_south = default_piece_move(default_piece_id(1), direction::SOUTH());
+	const auto c_east = default_piece_move(default_piece_id(2), direction::EAST());
+
+	{
+		// the interleavings in between are missing, e.g. because piece b blocks piece a otherwise:
+		const std::vector<default_move_path> paths{
+			make_path({ a_north, b_south, c_east }),
+			make_path({ c_east, b_south, a_north })
+		};
+
+		EXPECT_EQ(default_move_path::interleaving_partitioning(paths).size(), 2);
+		EXPECT_EQ(default_move_path::interleaving_partitioning_by_normal_form(paths).size(), 1);
+	}
+	{
+		// moves of the same piece:
+		const std::vector<default_move_path> paths{
+			make_path({ a_north, a_west }),
+			make_path({ a_west, a_north })
+		};
+
+		EXPECT_EQ(default_move_path::interleaving_partitioning(paths).size(), 1);
+		EXPECT_EQ(default_move_path::interleaving_partitioning_by_normal_form(paths).size(), 2);
+	}
+}
+
+TEST(tobor__v1_1__dynamic_rectangle_world, wall_masks) {
+	tobor::v1_1::default_dynamic_rectangle_world world(16, 16);
+	world.block_center_cells(2, 2);
+
+	EXPECT_EQ(world.row_wall_mask(0), (uint64_t(1) << 16) | 1);
+	EXPECT_EQ(world.column_wall_mask(0), (uint64_t(1) << 16) | 1);
+
+	// blocked cells (7, 7), (8, 7), (7, 8), (8, 8):
+	const uint64_t center_mask{ (uint64_t(1) << 16) | (uint64_t(1) << 9) | (uint64_t(1) << 8) | (uint64_t(1) << 7) | 1 };
+	EXPECT_EQ(world.row_wall_mask(7), center_mask);
+	EXPECT_EQ(world.row_wall_mask(8), center_mask);
+	EXPECT_EQ(world.column_wall_mask(7), center_mask);
+	EXPECT_EQ(world.column_wall_mask(8), center_mask);
+
+	world.west_wall_by_id(world.coordinates_to_cell_id(3, 2)) = true;
+	EXPECT_EQ(world.row_wall_mask(2), (uint64_t(1) << 16) | (uint64_t(1) << 3) | 1);
+	EXPECT_TRUE(world.east_wall_by_id(world.coordinates_to_cell_id(2, 2)));
+
+	world.west_wall_by_id(world.coordinates_to_cell_id(3, 2)) = false;
+	EXPECT_EQ(world.row_wall_mask(2), (uint64_t(1) << 16) | 1);
+}
+
+TEST(tobor__v1_1__dynamic_rectangle_world, stable_wall_hash) {
+	tobor::v1_1::default_dynamic_rectangle_world world(16, 16);
+	world.block_center_cells(2, 2);
+
+	auto copy = world;
+	EXPECT_TRUE(copy == world);
+	EXPECT_EQ(copy.wall_hash(), world.wall_hash());
+
+	// the hash must not change across platforms or versions since it may be persisted:
+	EXPECT_EQ(world.wall_hash(), 0x74de5888c38aa49full);
+
+	copy.south_wall_by_transposed_id(copy.coordinates_to_transposed_cell_id(3, 2)) = true;
+	EXPECT_FALSE(copy == world);
+	EXPECT_NE(copy.wall_hash(), world.wall_hash());
+}
+
+TEST(tobor__v1_1__positions_of_pieces, zobrist_hash) {
+	using world_type = tobor::v1_1::default_dynamic_rectangle_world;
+	using cell_id_type = tobor::v1_1::default_min_size_cell_id;
+	using sorted_type = tobor::v1_1::positions_of_pieces<tobor::v1_1::default_pieces_quantity, cell_id_type, true, true>;
+	using unsorted_type = tobor::v1_1::positions_of_pieces<tobor::v1_1::default_pieces_quantity, cell_id_type, false, false>;
+	using piece_move_type = tobor::v1_1::piece_move<tobor::v1_1::piece_id<tobor::v1_1::default_pieces_quantity>>;
+	using move_engine_type = tobor::v1_1::move_engine<cell_id_type, tobor::v1_1::quick_move_cache<world_type>, piece_move_type>;
+
+	world_type world(16, 16);
+	world.block_center_cells(2, 2);
+
+	const auto cell = [&](uint8_t x, uint8_t y) { return cell_id_type::create_by_coordinates(x, y, world); };
+
+	const sorted_type sorted({ cell(3, 4) }, { cell(15, 0), cell(0, 15), cell(2, 2) });
+	const unsorted_type unsorted({ cell(3, 4) }, { cell(0, 15), cell(2, 2), cell(15, 0) });
+	const tobor::v1_1::augmented_positions_of_pieces<tobor::v1_1::default_pieces_quantity, cell_id_type, true, true> augmented({ cell(3, 4) }, { cell(2, 2), cell(15, 0), cell(0, 15) });
+
+	EXPECT_EQ(sorted.zobrist_hash(), unsorted.zobrist_hash());
+	EXPECT_EQ(sorted.zobrist_hash(), augmented.zobrist_hash());
+	EXPECT_EQ(std::hash<sorted_type>()(sorted), sorted.hash());
+
+	// target and non-target pieces have different keys:
+	const sorted_type exchanged({ cell(2, 2) }, { cell(15, 0), cell(0, 15), cell(3, 4) });
+	EXPECT_NE(sorted.zobrist_hash(), exchanged.zobrist_hash());
+
+	const move_engine_type engine(world);
+
+	std::unordered_set<sorted_type> successors;
+	std::set<sorted_type> ordered_successors;
+	for (auto pid = move_engine_type::piece_id_type::begin(); pid < move_engine_type::piece_id_type::end(); ++pid) {
+		for (auto dir = tobor::v1_1::direction::begin(); dir < tobor::v1_1::direction::end(); ++dir) {
+			uint64_t hash{ sorted.zobrist_hash() };
+			const sorted_type successor{ engine.successor_state(sorted, pid, dir, hash) };
+			EXPECT_EQ(hash, successor.zobrist_hash());
+			EXPECT_TRUE(successor == engine.successor_state(sorted, pid, dir));
+			successors.insert(successor);
+			ordered_successors.insert(successor);
+		}
+	}
+	EXPECT_EQ(successors.size(), ordered_successors.size());
+}
+
+TEST(tobor__v1_1__move_engine, predecessor_sinks_match_predecessor_states) {
+	using world_type = tobor::v1_1::default_dynamic_rectangle_world;
+	using cell_id_type = tobor::v1_1::default_min_size_cell_id;
+	using state_type = tobor::v1_1::positions_of_pieces<tobor::v1_1::default_pieces_quantity, cell_id_type, true, true>;
+	using piece_move_type = tobor::v1_1::piece_move<tobor::v1_1::piece_id<tobor::v1_1::default_pieces_quantity>>;
+	using move_engine_type = tobor::v1_1::move_engine<cell_id_type, tobor::v1_1::quick_move_cache<world_type>, piece_move_type>;
+	using piece_id_type = move_engine_type::piece_id_type;
+	using edge_type = move_engine_type::predecessor_edge<state_type>;
+
+	world_type world(16, 16);
+	world.block_center_cells(2, 2);
+	world.west_wall_by_id(world.coordinates_to_cell_id(5, 3)) = true;
+	world.east_wall_by_id(world.coordinates_to_cell_id(10, 12)) = true;
+
+	const move_engine_type engine(world);
+
+	const auto cell = [&](uint8_t x, uint8_t y) { return cell_id_type::create_by_coordinates(x, y, world); };
+
+	// random walk through reachable states:
+	std::vector<state_type> states{ state_type({ cell(3, 4) }, { cell(15, 0), cell(0, 15), cell(9, 2) }) };
+	uint64_t random{ 4711 };
+	while (states.size() < 100) {
+		random = random * 6364136223846793005ull + 1442695040888963407ull;
+		const piece_id_type pid(static_cast<uint8_t>((random >> 33) % tobor::v1_1::default_pieces_quantity::COUNT_ALL_PIECES));
+		direction dir{ direction::begin() };
+		for (uint64_t k{ (random >> 40) % 4 }; k > 0; --k) ++dir;
+
+		const state_type successor{ engine.successor_state(states.back(), pid, dir) };
+		if (successor == states.back()) continue; // no move
+		states.push_back(successor);
+	}
+
+	for (const auto& state : states) {
+		const std::vector<state_type> expected = engine.predecessor_states(state);
+
+		std::vector<state_type> per_piece;
+		for (auto pid = piece_id_type::begin(); pid < piece_id_type::end(); ++pid) {
+			const std::vector<state_type> piece_predecessors = engine.predecessor_states(state, pid);
+
+			std::vector<state_type> written;
+			engine.add_predecessor_states(state, pid, std::back_inserter(written));
+			EXPECT_EQ(written, piece_predecessors);
+
+			per_piece.insert(per_piece.end(), written.cbegin(), written.cend());
+		}
+		EXPECT_EQ(per_piece, expected);
+
+		std::vector<state_type> buffer(engine.max_count_predecessor_states(), state);
+		const auto end{ engine.add_predecessor_states(state, buffer.begin()) };
+		EXPECT_EQ(std::vector<state_type>(buffer.begin(), end), expected);
+	}
+
+	std::vector<edge_type> edges;
+	engine.add_predecessor_edges<state_type>(states.cbegin(), states.cend(), std::back_inserter(edges));
+
+	std::vector<state_type> edge_predecessors;
+	std::vector<state_type> expected_predecessors;
+	for (const auto& state : states) {
+		const std::vector<state_type> predecessors = engine.predecessor_states(state);
+		expected_predecessors.insert(expected_predecessors.end(), predecessors.cbegin(), predecessors.cend());
+	}
+	for (const auto& edge : edges) {
+		EXPECT_TRUE(engine.successor_state(edge.predecessor, edge.move) == edge.successor);
+		edge_predecessors.push_back(edge.predecessor);
+	}
+	EXPECT_EQ(edge_predecessors, expected_predecessors);
+}
+
+TEST(tobor__v1_1__simple_state_digraph, allocates_from_memory_resource) {
+	struct counting_resource : std::pmr::memory_resource {
+		std::size_t count_allocations{ 0 };
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+			++count_allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	};
+
+	using graph_type = tobor::v1_1::simple_state_digraph<int, std::vector<bool>>;
+
+	counting_resource resource;
+	graph_type graph(&resource);
+
+	graph.map[1].successors.insert(2);
+	graph.map[2].predecessors.insert(1);
+	graph.map.try_emplace(3).first->second.predecessors.insert(2);
+
+	// 3 map nodes, 3 set nodes:
+	EXPECT_EQ(resource.count_allocations, 6u);
+	EXPECT_EQ(graph.map[3].successors.get_allocator().resource(), &resource);
+
+	const graph_type copy(graph);
+	EXPECT_EQ(resource.count_allocations, 6u);
+	EXPECT_EQ(copy.map.size(), 3u);
+}
+
+TEST(tobor__v1_1__augmented_positions_of_pieces, compact_permutation_tracks_colors) {
+	using world_type = tobor::v1_1::default_dynamic_rectangle_world;
+	using cell_id_type = tobor::v1_1::default_min_size_cell_id;
+	using pieces_quantity_type = tobor::v1_1::uint8_t_pieces_quantity<2, 3>;
+	using augmented_type = tobor::v1_1::augmented_positions_of_pieces<pieces_quantity_type, cell_id_type, true, true>;
+	using by_color_type = tobor::v1_1::positions_of_pieces<pieces_quantity_type, cell_id_type, false, false>;
+	using piece_id_type = tobor::v1_1::piece_id<pieces_quantity_type>;
+	using piece_move_type = tobor::v1_1::piece_move<piece_id_type>;
+	using move_engine_type = tobor::v1_1::move_engine<cell_id_type, tobor::v1_1::quick_move_cache<world_type>, piece_move_type>;
+	using move_path_type = tobor::v1_1::move_path<piece_move_type>;
+
+	static_assert(sizeof(augmented_type::permutation_type) == pieces_quantity_type::COUNT_ALL_PIECES);
+
+	world_type world(16, 16);
+	world.block_center_cells(2, 2);
+	world.west_wall_by_id(world.coordinates_to_cell_id(5, 3)) = true;
+	world.south_wall_by_transposed_id(world.coordinates_to_transposed_cell_id(9, 12)) = true;
+
+	const move_engine_type engine(world);
+
+	const auto cell = [&](uint8_t x, uint8_t y) { return cell_id_type::create_by_coordinates(x, y, world); };
+
+	// pieces in color order, deliberately unsorted:
+	by_color_type by_color({ cell(12, 3), cell(1, 14) }, { cell(7, 7), cell(15, 0), cell(3, 2) });
+
+	tobor::v1_1::state_path<augmented_type> path;
+	path.vector().emplace_back(augmented_type({ cell(12, 3), cell(1, 14) }, { cell(7, 7), cell(15, 0), cell(3, 2) }));
+
+	std::vector<piece_move_type> color_moves;
+
+	uint64_t random{ 12345 };
+	for (std::size_t step{ 0 }; step < 40; ++step) {
+		random = random * 6364136223846793005ull + 1442695040888963407ull;
+		const piece_id_type color(static_cast<uint8_t>((random >> 33) % pieces_quantity_type::COUNT_ALL_PIECES));
+		tobor::v1_1::direction dir{ tobor::v1_1::direction::begin() };
+		for (uint64_t k{ (random >> 40) % 4 }; k > 0; --k) ++dir;
+
+		const auto& state{ path.vector().back() };
+		const auto& perm{ state.permutation() };
+		const piece_id_type sorted_id(static_cast<uint8_t>(std::find(perm.cbegin(), perm.cend(), color.value) - perm.cbegin()));
+
+		const augmented_type successor{ engine.successor_state(state, sorted_id, dir) };
+		by_color = engine.successor_state(by_color, color, dir);
+
+		for (uint8_t i{ 0 }; i < pieces_quantity_type::COUNT_ALL_PIECES; ++i) {
+			EXPECT_EQ(successor.piece_positions()[i], by_color.piece_positions()[successor.permutation()[i]]);
+		}
+
+		if (successor == state) continue; // no move
+
+		color_moves.emplace_back(color, dir);
+		path.vector().push_back(successor);
+	}
+
+	ASSERT_GT(color_moves.size(), 10u);
+
+	const move_path_type extracted{ move_path_type::extract_unsorted_move_path(path, engine) };
+
+	ASSERT_EQ(extracted.vector().size(), color_moves.size());
+	for (std::size_t i{ 0 }; i < color_moves.size(); ++i) {
+		EXPECT_EQ(extracted.vector()[i].pid.value, color_moves[i].pid.value);
+		EXPECT_EQ(extracted.vector()[i].dir.get(), color_moves[i].dir.get());
+	}
+}
+
+TEST(tobor__v1_1__compact_state_path, matches_full_state_path) {
+	using world_type = tobor::v1_1::default_dynamic_rectangle_world;
+	using cell_id_type = tobor::v1_1::default_min_size_cell_id;
+	using pieces_quantity_type = tobor::v1_1::uint8_t_pieces_quantity<2, 3>;
+	using augmented_type = tobor::v1_1::augmented_positions_of_pieces<pieces_quantity_type, cell_id_type, true, true>;
+	using piece_id_type = tobor::v1_1::piece_id<pieces_quantity_type>;
+	using piece_move_type = tobor::v1_1::piece_move<piece_id_type>;
+	using move_engine_type = tobor::v1_1::move_engine<cell_id_type, tobor::v1_1::quick_move_cache<world_type>, piece_move_type>;
+	using compact_path_type = tobor::v1_1::compact_state_path<augmented_type, move_engine_type, 4>;
+
+	world_type world(16, 16);
+	world.block_center_cells(2, 2);
+	world.west_wall_by_id(world.coordinates_to_cell_id(5, 3)) = true;
+
+	const move_engine_type engine(world);
+
+	const auto cell = [&](uint8_t x, uint8_t y) { return cell_id_type::create_by_coordinates(x, y, world); };
+
+	tobor::v1_1::state_path<augmented_type> full;
+	full.vector().emplace_back(augmented_type({ cell(12, 3), cell(1, 14) }, { cell(7, 7), cell(15, 0), cell(3, 2) }));
+
+	compact_path_type compact(engine, full.vector().front());
+
+	uint64_t random{ 777 };
+	while (full.vector().size() < 30) {
+		random = random * 6364136223846793005ull + 1442695040888963407ull;
+		const piece_id_type pid(static_cast<uint8_t>((random >> 33) % pieces_quantity_type::COUNT_ALL_PIECES));
+		tobor::v1_1::direction dir{ tobor::v1_1::direction::begin() };
+		for (uint64_t k{ (random >> 40) % 4 }; k > 0; --k) ++dir;
+
+		const piece_move_type move(pid, dir);
+		EXPECT_EQ(compact_path_type::decode(compact_path_type::encode(move)).pid.value, move.pid.value);
+		EXPECT_EQ(compact_path_type::decode(compact_path_type::encode(move)).dir.get(), move.dir.get());
+
+		const augmented_type successor{ engine.successor_state(full.vector().back(), move) };
+		if (successor == full.vector().back()) continue; // no move
+
+		full.vector().push_back(successor);
+		compact.push_back(move);
+		EXPECT_EQ(compact.back(), successor);
+	}
+
+	const auto check_equal = [&]() {
+		ASSERT_EQ(compact.size(), full.vector().size());
+		for (std::size_t i{ 0 }; i < full.vector().size(); ++i) {
+			EXPECT_EQ(compact[i], full.vector()[i]);
+		}
+		EXPECT_EQ(compact.expand().vector(), full.vector());
+	};
+
+	check_equal();
+
+	const compact_path_type from_full(engine, full);
+	EXPECT_EQ(from_full.expand().vector(), full.vector());
+
+	for (std::size_t i{ 0 }; i < 6; ++i) { // crosses checkpoints
+		compact.pop_back();
+		full.vector().pop_back();
+		check_equal();
+	}
+
+	compact.truncate(9);
+	full.vector().erase(full.vector().begin() + 9, full.vector().end());
+	check_equal();
+
+	compact.push_back(from_full.move(8));
+	full.vector().push_back(from_full[9]);
+	check_equal();
+}
@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+
+#include "default_models_1_1.h"
+
+#include "../src/engine/quick_move_cache.h"
+
+#include <random>
+
+namespace {
+
+	using world_type = tobor::v1_1::default_dynamic_rectangle_world;
+	using cache_type = tobor::v1_1::quick_move_cache<world_type>;
+	using tobor::v1_1::direction;
+
+	void expect_equal_caches(const cache_type& incremental, const world_type& world) {
+		const cache_type fresh(world);
+		for (std::size_t raw_id = 0; raw_id < world.count_cells(); ++raw_id) {
+			for (direction d = direction::begin(); d != direction::end(); ++d) {
+				ASSERT_EQ(incremental.get(d, raw_id), fresh.get(d, raw_id)) << "raw id " << raw_id << " direction " << d.to_char();
+			}
+		}
+	}
+
+}
+
+TEST(tobor__v1_1__quick_move_cache, update_wall_matches_full_update) {
+	world_type world(16, 16);
+	world.block_center_cells(2, 2);
+
+	cache_type cache(world);
+	expect_equal_caches(cache, world);
+
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<std::size_t> cell_distribution(0, world.count_cells() - 1);
+	std::uniform_int_distribution<int> direction_distribution(0, 3);
+
+	for (int i = 0; i < 500; ++i) {
+		const std::size_t id{ cell_distribution(generator) };
+		const std::size_t transposed_id{ world.cell_id_to_transposed_cell_id(id) };
+
+		direction d = direction::begin();
+		for (int k = direction_distribution(generator); k > 0; --k) {
+			++d;
+		}
+
+		switch (d.get()) {
+		case direction::encoding::NORTH:
+			world.north_wall_by_transposed_id(transposed_id) = !world.north_wall_by_transposed_id(transposed_id);
+			break;
+		case direction::encoding::EAST:
+			world.east_wall_by_id(id) = !world.east_wall_by_id(id);
+			break;
+		case direction::encoding::SOUTH:
+			world.south_wall_by_transposed_id(transposed_id) = !world.south_wall_by_transposed_id(transposed_id);
+			break;
+		default:
+			world.west_wall_by_id(id) = !world.west_wall_by_id(id);
+		}
+
+		cache.update_wall(id, d);
+
+		expect_equal_caches(cache, world);
+	}
+}
@@ -0,0 +1,58 @@
+#include "gtest/gtest.h"
+
+#include "../src/random_game_generator.h"
+
+#include "../src/models/pieces_quantity.h"
+
+#include <random>
+
+using random_pieces_quantity = tobor::v1_1::pieces_quantity<uint8_t, 1, 3>;
+
+using random_generator_type = RandomGameGenerator<random_pieces_quantity>;
+
+TEST(random_game_generator, worlds_follow_original_conventions) {
+	using world_generator_type = tobor::v1_1::world_generator::random_world_generator;
+
+	const world_generator_type world_generator;
+
+	std::mt19937_64 engine(42);
+
+	for (std::size_t i{ 0 }; i < 20; ++i) {
+		const auto world{ world_generator(engine) };
+
+		EXPECT_EQ(world.get_horizontal_size(), 16);
+		EXPECT_EQ(world.get_vertical_size(), 16);
+		EXPECT_EQ(world.blocked_cells(), 4);
+		EXPECT_EQ(tobor::v1_1::world_generator::original_4_of_16::get_target_cell_id_vector(world).size(), world_generator.count_target_cells());
+	}
+}
+
+TEST(random_game_generator, accepted_games_meet_requirements) {
+	const random_generator_type generator;
+
+	random_generator_type::requirements req;
+	req.min_optimal_length = 3;
+	req.max_optimal_length = 5;
+	req.max_solution_classes = 2;
+
+	const auto games{ generator.generate(4, req, 7, 16, 2048) };
+
+	ASSERT_EQ(games.size(), 4);
+
+	for (const auto& g : games) {
+		EXPECT_GE(g.optimal_length, req.min_optimal_length);
+		EXPECT_LE(g.optimal_length, req.max_optimal_length);
+		EXPECT_GE(g.count_solution_classes, 1);
+		EXPECT_LE(g.count_solution_classes, req.max_solution_classes);
+	}
+
+	// independent of batch size:
+	const auto same_games{ generator.generate(4, req, 7, 5, 2048) };
+
+	ASSERT_EQ(same_games.size(), games.size());
+	for (std::size_t i{ 0 }; i < games.size(); ++i) {
+		EXPECT_TRUE(same_games[i].world == games[i].world);
+		EXPECT_EQ(same_games[i].target_cell, games[i].target_cell);
+		EXPECT_EQ(same_games[i].optimal_length, games[i].optimal_length);
+	}
+}
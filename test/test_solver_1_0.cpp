@@ -6,7 +6,6 @@
 #include <array>
 
 
-/*
 TEST(engine, example_integration) {
 	// check the following scenario:
 	// create world
@@ -75,12 +74,36 @@ TEST(engine, example_integration) {
 
 	auto w_analyzer = tobor::v1_0::default_legacy_move_engine(w);
 
-	auto partial_state_graph = tobor::v1_0::partial_state_graph<tobor::v1_0::default_legacy_move_engine>(target_robots, other_robots);
+	auto partial_state_graph = tobor::v1_0::partial_state_graph<tobor::v1_0::default_legacy_move_engine, tobor::v1_0::default_state_graph_node>(target_robots, other_robots);
 
 	partial_state_graph.explore_until_optimal_solution_distance(w_analyzer, target);
 
 	ASSERT_EQ(9, partial_state_graph.get_optimal_path_length());
 
+	partial_state_graph.remove_dead_states(target);
+
+	const auto optimal_paths = partial_state_graph.optimal_move_paths(target);
+
+	ASSERT_FALSE(optimal_paths.empty());
+
+	const tobor::v1_0::default_positions_of_pieces initial_state(target_robots, other_robots);
+
+	for (const auto& [final_state, paths] : optimal_paths) {
+		EXPECT_TRUE(final_state.is_final(target));
+		ASSERT_FALSE(paths.empty());
+
+		// each path replays from the initial state to its final state:
+		for (const auto& path : paths) {
+			ASSERT_EQ(9, path.vector().size());
+
+			auto state = initial_state;
+			for (const auto& move : path.vector()) {
+				const auto [next_state, moved] = w_analyzer.successor_state(state, move);
+				EXPECT_TRUE(moved);
+				state = next_state;
+			}
+			EXPECT_EQ(final_state, state);
+		}
+	}
 }
-*/
 
@@ -0,0 +1,197 @@
+#include "gtest/gtest.h"
+
+#include "../src/solver_daemon.h"
+
+#include <nlohmann/json.hpp>
+
+#include <set>
+#include <sstream>
+#include <string>
+
+#ifndef _WIN32
+	#include <sys/socket.h>
+	#include <unistd.h>
+#endif
+
+namespace {
+
+	const std::string GENERATED_WORLD_REQUEST{
+		R"({"pieces": {"target": 1, "non_target": 3}, "world": {"counter": 5}, "initial_state": {"target_pieces": [[0, 0]], "non_target_pieces": [[15, 0], [0, 15], [15, 15]]}})"
+	};
+
+}
+
+TEST(solver_daemon, solves_like_solver_environment) {
+	using session_type = SolverSession<tobor::v1_1::pieces_quantity<uint8_t, 1, 3>>;
+
+	SolverDaemon daemon(2);
+
+	nlohmann::json request = nlohmann::json::parse(GENERATED_WORLD_REQUEST);
+	request["id"] = 17;
+
+	const nlohmann::json response = nlohmann::json::parse(daemon.handle(request.dump()));
+
+	ASSERT_EQ(response.at("status"), "ok");
+	EXPECT_EQ(response.at("id"), 17);
+
+	const auto [world, target_cell] = session_type::world_from_json(request.at("world"));
+	ASSERT_TRUE(target_cell.has_value());
+	const auto board{ BoardRegistry<session_type::pieces_quantity_type>::instance().get(world) };
+
+	const session_type::positions_of_pieces_type_interactive initial_state(
+		{ session_type::cell_id_type::create_by_coordinates(0, 0, world) },
+		{
+			session_type::cell_id_type::create_by_coordinates(15, 0, world),
+			session_type::cell_id_type::create_by_coordinates(0, 15, world),
+			session_type::cell_id_type::create_by_coordinates(15, 15, world)
+		}
+	);
+	const session_type::solver_environment_type solver(initial_state, target_cell.value(), board->move_engine());
+	const auto solutions{ solver.optimal_solutions() };
+
+	ASSERT_EQ(response.at("solutions").size(), solutions.size());
+	EXPECT_EQ(response.at("optimal_length"), solutions.front().second.vector().size());
+	for (std::size_t i{ 0 }; i < solutions.size(); ++i) {
+		const auto& moves{ response.at("solutions").at(i) };
+		ASSERT_EQ(moves.size(), solutions[i].second.vector().size());
+		for (std::size_t j{ 0 }; j < moves.size(); ++j) {
+			EXPECT_EQ(moves.at(j).at("piece"), solutions[i].second.vector()[j].pid.value);
+			EXPECT_EQ(moves.at(j).at("direction"), std::string(1, solutions[i].second.vector()[j].dir.to_char()));
+		}
+	}
+}
+
+TEST(solver_daemon, answers_every_line_concurrently) {
+	SolverDaemon daemon(3);
+
+	std::stringstream in;
+	for (int id{ 0 }; id < 6; ++id) {
+		nlohmann::json request = nlohmann::json::parse(GENERATED_WORLD_REQUEST);
+		request["id"] = id;
+		request["world"]["counter"] = id;
+		in << request.dump() << "\n";
+	}
+	in << "\n" << R"({"id": 6, "pieces": {"target": 1, "non_target": 9}})" << "\n" << "no json\n";
+
+	std::stringstream out;
+	daemon.serve(in, out);
+
+	std::set<int> ok_ids;
+	std::size_t count_errors{ 0 };
+	std::string line;
+	while (std::getline(out, line)) {
+		const nlohmann::json response = nlohmann::json::parse(line);
+		if (response.at("status") == "error") {
+			++count_errors;
+			EXPECT_FALSE(response.at("message").get<std::string>().empty());
+		}
+		else {
+			EXPECT_EQ(response.at("status"), "ok");
+			ok_ids.insert(response.at("id").get<int>());
+		}
+	}
+
+	EXPECT_EQ(ok_ids, (std::set<int>{ 0, 1, 2, 3, 4, 5 }));
+	EXPECT_EQ(count_errors, 2);
+}
+
+TEST(solver_daemon, answers_invalid_utf8_with_error) {
+	SolverDaemon daemon(1);
+
+	const nlohmann::json response = nlohmann::json::parse(daemon.handle("{\"id\": 1, \"world\": \"\xff\"}"));
+
+	EXPECT_EQ(response.at("status"), "error");
+	EXPECT_FALSE(response.at("message").get<std::string>().empty());
+}
+
+TEST(solver_daemon, rejects_worlds_exceeding_cell_ids) {
+	SolverDaemon daemon(1);
+
+	nlohmann::json request = nlohmann::json::parse(GENERATED_WORLD_REQUEST);
+	request["world"] = { { "width", 20 }, { "height", 20 } };
+
+	const nlohmann::json response = nlohmann::json::parse(daemon.handle(request.dump()));
+
+	EXPECT_EQ(response.at("status"), "error");
+	EXPECT_EQ(response.at("message"), "world has too many cells");
+}
+
+TEST(solver_daemon, rejects_invalid_max_depth) {
+	SolverDaemon daemon(1);
+
+	for (const nlohmann::json& max_depth : { nlohmann::json(-1), nlohmann::json(2.5), nlohmann::json("3") }) {
+		nlohmann::json request = nlohmann::json::parse(GENERATED_WORLD_REQUEST);
+		request["max_depth"] = max_depth;
+
+		const nlohmann::json response = nlohmann::json::parse(daemon.handle(request.dump()));
+
+		EXPECT_EQ(response.at("status"), "error");
+		EXPECT_EQ(response.at("message"), "invalid max_depth: " + max_depth.dump());
+	}
+
+	nlohmann::json request = nlohmann::json::parse(GENERATED_WORLD_REQUEST);
+	request["max_depth"] = 2;
+	EXPECT_EQ(nlohmann::json::parse(daemon.handle(request.dump())).at("status"), "not_found");
+}
+
+TEST(solver_daemon, evicts_explorers_beyond_cache_budget) {
+	using session_type = SolverSession<tobor::v1_1::pieces_quantity<uint8_t, 1, 3>>;
+
+	std::vector<nlohmann::json> requests;
+	for (int counter{ 0 }; counter < 3; ++counter) {
+		nlohmann::json request = nlohmann::json::parse(GENERATED_WORLD_REQUEST);
+		request["world"]["counter"] = counter;
+		requests.push_back(request);
+	}
+
+	session_type unbounded;
+	std::size_t largest_bytes{ 0 };
+	for (const auto& request : requests) {
+		const std::size_t before{ unbounded.cached_bytes() };
+		ASSERT_EQ(unbounded.solve(request).at("status"), "ok");
+		largest_bytes = std::max(largest_bytes, unbounded.cached_bytes() - before);
+	}
+	EXPECT_EQ(unbounded.count_cached_explorers(), requests.size());
+
+	session_type bounded(largest_bytes);
+	for (const auto& request : requests) {
+		EXPECT_EQ(bounded.solve(request), unbounded.solve(request));
+		EXPECT_LE(bounded.cached_bytes(), largest_bytes);
+		EXPECT_GE(bounded.count_cached_explorers(), 1); // the most recent one always fits
+	}
+	EXPECT_LT(bounded.count_cached_explorers(), requests.size());
+
+	session_type without_cache(0);
+	EXPECT_EQ(without_cache.solve(requests.front()).at("status"), "ok");
+	EXPECT_EQ(without_cache.count_cached_explorers(), 0);
+}
+
+#ifndef _WIN32
+TEST(solver_daemon, joins_client_threads_on_destruction) {
+	int fds[2];
+	ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+	{
+		SolverDaemon daemon(1);
+		daemon.serve_client(fds[0]);
+
+		nlohmann::json request = nlohmann::json::parse(GENERATED_WORLD_REQUEST);
+		request["id"] = 3;
+		const std::string line{ request.dump() + "\n" };
+		ASSERT_EQ(::write(fds[1], line.data(), line.size()), static_cast<ssize_t>(line.size()));
+
+		std::string response;
+		char c;
+		while (::read(fds[1], &c, 1) == 1 && c != '\n') {
+			response.push_back(c);
+		}
+		EXPECT_EQ(nlohmann::json::parse(response).at("id"), 3);
+
+		// the client stays connected while the daemon is destroyed
+	}
+
+	char c;
+	EXPECT_EQ(::read(fds[1], &c, 1), 0); // disconnected by the daemon
+	::close(fds[1]);
+}
+#endif
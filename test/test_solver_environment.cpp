@@ -0,0 +1,335 @@
+#include "gtest/gtest.h"
+
+#include "../src/solver_environment.h"
+#include "../src/board_registry.h"
+#include "../src/engine_benchmark.h"
+#include "../src/world_generator_1_1.h"
+
+#include "../src/models/pieces_quantity.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <stop_token>
+#include <vector>
+
+namespace {
+
+	using solver_pieces_quantity = tobor::v1_1::pieces_quantity<uint8_t, 1, 3>;
+
+	using solver_environment_type = SolverEnvironment<solver_pieces_quantity>;
+
+	using engine_typeset = ClassicEngineTypeSet<solver_pieces_quantity>;
+
+	using cell_id_type = engine_typeset::cell_id_type;
+
+	using positions_of_pieces_type_interactive = engine_typeset::positions_of_pieces_type_interactive;
+
+	using piece_move_type = engine_typeset::piece_move_type;
+
+	using move_engine_type = engine_typeset::move_engine_type;
+
+	/**
+	*	@brief Checks that \p color_aware_move, which refers to pieces by color, leads from \p from to \p to.
+	*/
+	void expect_color_aware_move(const move_engine_type& engine, const positions_of_pieces_type_interactive& from, const positions_of_pieces_type_interactive& to, const piece_move_type& color_aware_move) {
+		const piece_move_type move{ engine.state_minus_state(to, from) }; // refers to pieces by sorted index
+		EXPECT_EQ(from.permutation()[move.pid.value], color_aware_move.pid.value);
+		EXPECT_TRUE(move.dir == color_aware_move.dir);
+		EXPECT_EQ(engine.successor_state(from, move), to);
+	}
+
+	void expect_same_solutions(const solver_environment_type& l, const solver_environment_type& r) {
+		const auto l_solutions{ l.optimal_solutions() };
+		const auto r_solutions{ r.optimal_solutions() };
+		ASSERT_EQ(l_solutions.size(), r_solutions.size());
+		for (std::size_t i{ 0 }; i < l_solutions.size(); ++i) {
+			EXPECT_EQ(l_solutions[i].first.vector(), r_solutions[i].first.vector());
+		}
+	}
+}
+
+TEST(solver_environment, reuses_distance_explorer_across_targets) {
+	const SharedBoard<solver_pieces_quantity> board(tobor::v1_1::world_generator::original_4_of_16().get_tobor_world());
+	const auto& world{ board.world() };
+
+	const positions_of_pieces_type_interactive initial_state(
+		{ cell_id_type::create_by_coordinates(0, 0, world) },
+		{
+			cell_id_type::create_by_coordinates(15, 0, world),
+			cell_id_type::create_by_coordinates(0, 15, world),
+			cell_id_type::create_by_coordinates(15, 15, world)
+		}
+	);
+
+	const cell_id_type near_target{ board.target_cells().front() };
+	const cell_id_type far_target{ board.target_cells().back() };
+
+	const solver_environment_type first(initial_state, far_target, board.move_engine());
+	ASSERT_EQ(first.status_code(), 0);
+
+	const auto explorer{ first.distance_explorer() };
+	const auto explored_depth{ explorer->exploration_depth() };
+
+	const solver_environment_type second(explorer, initial_state, near_target, board.move_engine());
+	const solver_environment_type second_fresh(initial_state, near_target, board.move_engine());
+
+	EXPECT_EQ(second.distance_explorer(), explorer);
+	EXPECT_GE(explorer->exploration_depth(), explored_depth);
+	expect_same_solutions(second, second_fresh);
+
+	const solver_environment_type again(explorer, initial_state, far_target, board.move_engine());
+	EXPECT_EQ(explorer->exploration_depth(), std::max(explored_depth, second_fresh.distance_explorer()->exploration_depth()));
+	expect_same_solutions(again, first);
+
+	const positions_of_pieces_type_interactive other_state(
+		{ cell_id_type::create_by_coordinates(1, 0, world) },
+		{
+			cell_id_type::create_by_coordinates(15, 0, world),
+			cell_id_type::create_by_coordinates(0, 15, world),
+			cell_id_type::create_by_coordinates(15, 15, world)
+		}
+	);
+	EXPECT_THROW(solver_environment_type(explorer, other_state, far_target, board.move_engine()), std::invalid_argument);
+}
+
+TEST(solver_environment, advance_max_depth_continues_exploration) {
+	const SharedBoard<solver_pieces_quantity> board(tobor::v1_1::world_generator::original_4_of_16().get_tobor_world());
+	const auto& world{ board.world() };
+
+	const positions_of_pieces_type_interactive initial_state(
+		{ cell_id_type::create_by_coordinates(0, 0, world) },
+		{
+			cell_id_type::create_by_coordinates(15, 0, world),
+			cell_id_type::create_by_coordinates(0, 15, world),
+			cell_id_type::create_by_coordinates(15, 15, world)
+		}
+	);
+
+	const cell_id_type target{ board.target_cells().back() };
+
+	const solver_environment_type complete(initial_state, target, board.move_engine());
+	ASSERT_EQ(complete.status_code(), 0);
+
+	solver_environment_type stepwise(initial_state, target, board.move_engine(), nullptr, 1);
+	std::size_t max_depth{ 1 };
+	while (stepwise.status_code() == 1) {
+		EXPECT_EQ(stepwise.distance_explorer()->exploration_depth(), max_depth);
+		stepwise.advance_max_depth(nullptr, ++max_depth);
+	}
+
+	ASSERT_EQ(stepwise.status_code(), 0);
+	expect_same_solutions(stepwise, complete);
+}
+
+TEST(distance_exploration, optimal_path_lengths_of_all_targets) {
+	using distance_exploration_type = solver_environment_type::distance_exploration_type;
+	using positions_of_pieces_type_solver = engine_typeset::positions_of_pieces_type_solver;
+
+	const SharedBoard<solver_pieces_quantity> board(tobor::v1_1::world_generator::original_4_of_16().get_tobor_world());
+	const auto& world{ board.world() };
+
+	const positions_of_pieces_type_solver initial_state(
+		{ cell_id_type::create_by_coordinates(0, 0, world) },
+		{
+			cell_id_type::create_by_coordinates(15, 0, world),
+			cell_id_type::create_by_coordinates(0, 15, world),
+			cell_id_type::create_by_coordinates(15, 15, world)
+		}
+	);
+
+	const std::vector<cell_id_type>& targets{ board.target_cells() };
+
+	distance_exploration_type limited(initial_state);
+	const auto limited_lengths{ limited.optimal_path_lengths(board.move_engine(), targets, distance_exploration_type::exploration_policy::FORCE_EXPLORATION_UNTIL_DEPTH(3)) };
+	EXPECT_LE(limited.exploration_depth(), 3);
+
+	distance_exploration_type all_at_once(initial_state);
+	const auto lengths{ all_at_once.optimal_path_lengths(board.move_engine(), targets) };
+
+	ASSERT_EQ(lengths.size(), targets.size());
+
+	std::size_t max_length{ 0 };
+	for (const auto& target : targets) {
+		distance_exploration_type single(initial_state);
+		const auto length{ single.explore_until_target(board.move_engine(), target) };
+		ASSERT_NE(lengths.find(target), lengths.cend());
+		EXPECT_EQ(lengths.at(target), length);
+		EXPECT_EQ(all_at_once.optimal_path_length(board.move_engine(), target, distance_exploration_type::exploration_policy::ONLY_CASHED()), length);
+		if (length <= 3) {
+			EXPECT_EQ(limited_lengths.at(target), length);
+		}
+		else {
+			EXPECT_EQ(limited_lengths.count(target), 0);
+		}
+		max_length = std::max(max_length, length);
+	}
+
+	EXPECT_EQ(all_at_once.exploration_depth(), max_length);
+}
+
+TEST(distance_exploration, stop_token_ends_exploration) {
+	using distance_exploration_type = solver_environment_type::distance_exploration_type;
+	using positions_of_pieces_type_solver = engine_typeset::positions_of_pieces_type_solver;
+
+	const SharedBoard<solver_pieces_quantity> board(tobor::v1_1::world_generator::original_4_of_16().get_tobor_world());
+	const auto& world{ board.world() };
+
+	const positions_of_pieces_type_solver initial_state(
+		{ cell_id_type::create_by_coordinates(0, 0, world) },
+		{
+			cell_id_type::create_by_coordinates(15, 0, world),
+			cell_id_type::create_by_coordinates(0, 15, world),
+			cell_id_type::create_by_coordinates(15, 15, world)
+		}
+	);
+
+	const cell_id_type target{ board.target_cells().back() };
+
+	distance_exploration_type unstopped(initial_state);
+	const auto length{ unstopped.explore_until_target(board.move_engine(), target) };
+	ASSERT_GT(length, 2);
+
+	distance_exploration_type explorer(initial_state);
+	explorer.explore(board.move_engine(), distance_exploration_type::exploration_policy::FORCE_EXPLORATION_UNTIL_DEPTH(2));
+	const auto count_states{ explorer.count_states() };
+
+	std::stop_source stop_source;
+	explorer.set_stop_token(stop_source.get_token());
+	stop_source.request_stop();
+
+	// only complete levels are kept:
+	EXPECT_EQ(explorer.explore_until_target(board.move_engine(), target), distance_exploration_type::SIZE_TYPE_MAX);
+	EXPECT_EQ(explorer.exploration_depth(), 2);
+	EXPECT_EQ(explorer.count_states(), count_states);
+	EXPECT_FALSE(explorer.entirely_explored());
+
+	explorer.set_stop_token(std::stop_token());
+	EXPECT_EQ(explorer.explore_until_target(board.move_engine(), target), length);
+	EXPECT_EQ(explorer.count_states(), unstopped.count_states());
+}
+
+TEST(solver_environment, single_solution_mode) {
+	const SharedBoard<solver_pieces_quantity> board(tobor::v1_1::world_generator::original_4_of_16().get_tobor_world());
+	const auto& world{ board.world() };
+
+	const positions_of_pieces_type_interactive initial_state(
+		{ cell_id_type::create_by_coordinates(0, 0, world) },
+		{
+			cell_id_type::create_by_coordinates(15, 0, world),
+			cell_id_type::create_by_coordinates(0, 15, world),
+			cell_id_type::create_by_coordinates(15, 15, world)
+		}
+	);
+
+	for (const auto& target : board.target_cells()) {
+		const solver_environment_type all(initial_state, target, board.move_engine());
+		ASSERT_EQ(all.status_code(), 0);
+
+		solver_environment_type single(initial_state, target, board.move_engine(), nullptr, solver_environment_type::distance_exploration_type::SIZE_TYPE_MAX, solver_environment_type::extraction_mode::SINGLE_SOLUTION);
+		ASSERT_EQ(single.status_code(), 0);
+		ASSERT_EQ(single.solutions_size(), 1);
+		EXPECT_FALSE(single.all_solutions_extracted());
+
+		const auto [state_path, move_path] { single.optimal_solutions().front() };
+		EXPECT_EQ(move_path.vector().size(), all.optimal_solutions().front().second.vector().size());
+		ASSERT_EQ(state_path.vector().size(), move_path.vector().size() + 1);
+		EXPECT_EQ(state_path.vector().front(), initial_state);
+		EXPECT_TRUE(state_path.vector().back().is_final(target));
+		for (std::size_t i{ 0 }; i < move_path.vector().size(); ++i) {
+			expect_color_aware_move(board.move_engine(), state_path.vector()[i], state_path.vector()[i + 1], move_path.vector()[i]);
+		}
+
+		single.extract_all_solutions();
+		EXPECT_TRUE(single.all_solutions_extracted());
+		expect_same_solutions(single, all);
+	}
+}
+
+TEST(solver_environment, near_optimal_solutions) {
+	const SharedBoard<solver_pieces_quantity> board(tobor::v1_1::world_generator::original_4_of_16().get_tobor_world());
+	const auto& world{ board.world() };
+
+	const positions_of_pieces_type_interactive initial_state(
+		{ cell_id_type::create_by_coordinates(0, 0, world) },
+		{
+			cell_id_type::create_by_coordinates(15, 0, world),
+			cell_id_type::create_by_coordinates(0, 15, world),
+			cell_id_type::create_by_coordinates(15, 15, world)
+		}
+	);
+
+	const cell_id_type target{ board.target_cells().front() };
+
+	solver_environment_type solver(initial_state, target, board.move_engine());
+	ASSERT_EQ(solver.status_code(), 0);
+
+	const std::size_t optimal_length{ solver.optimal_solutions().front().second.vector().size() };
+
+	EXPECT_EQ(solver.near_optimal_solutions(0).size(), solver.solutions_size());
+
+	for (std::size_t slack{ 1 }; slack <= 2; ++slack) {
+		const auto solutions{ solver.near_optimal_solutions(slack) };
+		EXPECT_FALSE(solutions.empty());
+
+		for (const auto& [state_path, move_path] : solutions) {
+			ASSERT_EQ(move_path.vector().size(), optimal_length + slack);
+			ASSERT_EQ(state_path.vector().size(), move_path.vector().size() + 1);
+			EXPECT_EQ(state_path.vector().front(), initial_state);
+			for (std::size_t i{ 0 }; i < move_path.vector().size(); ++i) {
+				expect_color_aware_move(board.move_engine(), state_path.vector()[i], state_path.vector()[i + 1], move_path.vector()[i]);
+				EXPECT_FALSE(state_path.vector()[i].is_final(target));
+			}
+			EXPECT_TRUE(state_path.vector().back().is_final(target));
+
+			std::vector<positions_of_pieces_type_interactive> states(state_path.vector());
+			std::sort(states.begin(), states.end());
+			EXPECT_EQ(std::adjacent_find(states.cbegin(), states.cend()), states.cend());
+		}
+	}
+}
+
+TEST(solver_environment, large_board_engine_type_set) {
+	using large_typeset = LargeBoardEngineTypeSet<solver_pieces_quantity>;
+	using large_cell_id_type = large_typeset::cell_id_type;
+
+	large_typeset::world_type world(40, 40);
+	world.block_center_cells(2, 2);
+	world.west_wall_by_id(large_cell_id_type::create_by_coordinates(30, 0, world).get_id()) = true;
+	world.south_wall_by_transposed_id(large_cell_id_type::create_by_coordinates(29, 35, world).get_transposed_id(world)) = true;
+
+	const large_typeset::move_engine_type engine(world);
+
+	const large_typeset::positions_of_pieces_type_interactive initial_state(
+		{ large_cell_id_type::create_by_coordinates(0, 0, world) },
+		{
+			large_cell_id_type::create_by_coordinates(39, 0, world),
+			large_cell_id_type::create_by_coordinates(0, 39, world),
+			large_cell_id_type::create_by_coordinates(39, 39, world)
+		}
+	);
+
+	// east to the wall west of (30, 0), then north to the wall south of (29, 35):
+	const auto target_cell{ large_cell_id_type::create_by_coordinates(29, 34, world) };
+
+	const SolverEnvironment<solver_pieces_quantity, large_typeset> solver(initial_state, target_cell, engine);
+
+	ASSERT_GT(solver.solutions_size(), 0);
+	const auto solutions{ solver.optimal_solutions() };
+	for (const auto& [state_path, move_path] : solutions) {
+		EXPECT_EQ(move_path.vector().size(), 2);
+		EXPECT_EQ(state_path.vector().back().piece_positions()[0], target_cell);
+	}
+}
+
+TEST(solver_environment, engine_type_sets_explore_equally) {
+	const auto results{ EngineBenchmark<solver_pieces_quantity>::run(5, 8793, 1) };
+
+	ASSERT_EQ(results.size(), 2);
+	EXPECT_EQ(results[0].optimal_length, 10);
+	EXPECT_EQ(results[0].optimal_length, results[1].optimal_length);
+	EXPECT_EQ(results[0].count_states, results[1].count_states);
+	EXPECT_EQ(results[0].cell_id_bytes, 1);
+	EXPECT_EQ(results[1].cell_id_bytes, 2);
+	EXPECT_EQ(results[0].explored_bytes * 2, results[1].explored_bytes);
+}
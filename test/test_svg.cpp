@@ -0,0 +1,131 @@
+#include "gtest/gtest.h"
+
+#include "../src/svg_1_1.h"
+#include "../src/svg_benchmark.h"
+#include "../src/world_generator_1_1.h"
+
+#include "default_models_1_1.h"
+
+#include <string>
+
+TEST(svg, path_output) {
+	namespace svg = tobor::v1_1::svg;
+
+	svg::svg_path path;
+
+	path.path_elements.push_back(std::make_shared<svg::svg_path_elements::M<double>>(1.5, 2));
+	path.path_elements.push_back(std::make_shared<svg::svg_path_elements::l<double>>(3, 0, 0, -4.25));
+	path.path_elements.push_back(std::make_shared<svg::svg_path_elements::a<double>>(
+		svg::svg_path_elements::a<double>::step(1, 2, 0, true, false, 0.5, -0.5)
+	));
+	path.path_elements.push_back(std::make_shared<svg::svg_path_elements::Z>());
+	path.fill() = "red";
+	path.stroke_width() = "2";
+
+	EXPECT_EQ(
+		path.get_svg(),
+		"<path d=\"M 1.500000 2.000000 l 3.000000 0.000000 0.000000 -4.250000 a 1.000000 2.000000 0.000000 1 0 0.500000 -0.500000 Z\" fill=\"red\" stroke-width=\"2\"/>"
+	);
+
+	std::string buffer{ "<g>" };
+	path.write_svg(buffer);
+	EXPECT_EQ(buffer, "<g>" + path.get_svg());
+}
+
+TEST(svg, full_board_rendering) {
+	using world_type = tobor::v1_1::dynamic_rectangle_world<uint16_t, uint8_t>;
+	using cell_id_type = tobor::v1_1::min_size_cell_id<world_type>;
+	using positions_of_pieces_type = tobor::v1_1::positions_of_pieces<tobor::v1_1::default_pieces_quantity, cell_id_type, false, true>;
+	using graphics = tobor::v1_1::tobor_graphics<world_type, positions_of_pieces_type>;
+
+	const world_type world{ tobor::v1_1::world_generator::original_4_of_16().get_tobor_world() };
+
+	const positions_of_pieces_type positions(
+		{ cell_id_type::create_by_coordinates(0, 0, world) },
+		{
+			cell_id_type::create_by_coordinates(15, 0, world),
+			cell_id_type::create_by_coordinates(0, 15, world),
+			cell_id_type::create_by_coordinates(15, 15, world)
+		}
+	);
+
+	const auto target_cell{ cell_id_type::create_by_coordinates(5, 5, world) };
+
+	const graphics::coloring coloring("#f4191c", "#ffbd02", "#00a340", "#4285f4");
+
+	const std::string svg{ graphics::draw_tobor_world(world, positions, target_cell, coloring, graphics::piece_shape_selection::DUCK) };
+
+	// rendering is deterministic:
+	EXPECT_EQ(graphics::draw_tobor_world(world, positions, target_cell, coloring, graphics::piece_shape_selection::DUCK), svg);
+	EXPECT_EQ(svg.rfind("<?xml", 0), 0);
+	EXPECT_EQ(svg.substr(svg.size() - 6), "</svg>");
+}
+
+TEST(svg, small_board_document) {
+	using world_type = tobor::v1_1::dynamic_rectangle_world<uint16_t, uint8_t>;
+	using cell_id_type = tobor::v1_1::min_size_cell_id<world_type>;
+	using positions_of_pieces_type = tobor::v1_1::positions_of_pieces<tobor::v1_1::default_pieces_quantity, cell_id_type, false, true>;
+	using graphics = tobor::v1_1::tobor_graphics<world_type, positions_of_pieces_type>;
+
+	world_type world(3, 2);
+	world.east_wall_by_id(0) = true;
+	world.west_wall_by_id(1) = true;
+
+	const positions_of_pieces_type positions(
+		{ cell_id_type::create_by_coordinates(0, 0, world) },
+		{
+			cell_id_type::create_by_coordinates(2, 0, world),
+			cell_id_type::create_by_coordinates(0, 1, world),
+			cell_id_type::create_by_coordinates(2, 1, world)
+		}
+	);
+
+	const graphics::coloring coloring("#f4191c", "#ffbd02", "#00a340", "#4285f4");
+
+	// rendered by the std::to_string based svg generator before switching to std::to_chars:
+	const std::string expected{
+		R"(<?xml version="1.0" standalone="no"?>)" "\n"
+		R"(<svg height="300.000000" width="300.000000" version="1.1" xmlns="http://www.w3.org/2000/svg">)" "\n"
+		R"(<path d="M 0.000000 0.000000 l 400.000000 0.000000 0.000000 300.000000 -400.000000 0.000000 Z" fill="lightyellow" stroke="lightyellow" stroke-width="0"/>)"
+		R"(<path d="M 150.000000 50.000000 l 100.000000 0.000000 l 0.000000 100.000000 l -100.000000 0.000000 Z" fill="#f4191c" stroke="#f4191c" stroke-width="0"/>)"
+		R"(<path d="M 48.500000 48.500000 l 3.000000 0.000000 0.000000 203.000000 -3.000000 0.000000 Z" fill="dimgrey" stroke="dimgrey" stroke-width="0"/>)"
+		R"(<path d="M 148.500000 48.500000 l 3.000000 0.000000 0.000000 203.000000 -3.000000 0.000000 Z" fill="dimgrey" stroke="dimgrey" stroke-width="0"/>)"
+		R"(<path d="M 248.500000 48.500000 l 3.000000 0.000000 0.000000 203.000000 -3.000000 0.000000 Z" fill="dimgrey" stroke="dimgrey" stroke-width="0"/>)"
+		R"(<path d="M 348.500000 48.500000 l 3.000000 0.000000 0.000000 203.000000 -3.000000 0.000000 Z" fill="dimgrey" stroke="dimgrey" stroke-width="0"/>)"
+		R"(<path d="M 48.500000 48.500000 l 0.000000 3.000000 203.000000 0.000000 0.000000 -3.000000 Z" fill="dimgrey" stroke="dimgrey" stroke-width="0"/>)"
+		R"(<path d="M 48.500000 148.500000 l 0.000000 3.000000 203.000000 0.000000 0.000000 -3.000000 Z" fill="dimgrey" stroke="dimgrey" stroke-width="0"/>)"
+		R"(<path d="M 48.500000 248.500000 l 0.000000 3.000000 203.000000 0.000000 0.000000 -3.000000 Z" fill="dimgrey" stroke="dimgrey" stroke-width="0"/>)"
+		R"(<path d="M 50.000000 245.000000 c -6.000000 0.000000 -6.000000 10.000000 0.000000 10.000000 l 100.000000 0.000000 c 6.000000 0.000000 6.000000 -10.000000 0.000000 -10.000000 Z" fill="black" stroke="black" stroke-width="0"/>)"
+		R"(<path d="M 50.000000 45.000000 c -6.000000 0.000000 -6.000000 10.000000 0.000000 10.000000 l 100.000000 0.000000 c 6.000000 0.000000 6.000000 -10.000000 0.000000 -10.000000 Z" fill="black" stroke="black" stroke-width="0"/>)"
+		R"(<path d="M 150.000000 245.000000 c -6.000000 0.000000 -6.000000 10.000000 0.000000 10.000000 l 100.000000 0.000000 c 6.000000 0.000000 6.000000 -10.000000 0.000000 -10.000000 Z" fill="black" stroke="black" stroke-width="0"/>)"
+		R"(<path d="M 150.000000 45.000000 c -6.000000 0.000000 -6.000000 10.000000 0.000000 10.000000 l 100.000000 0.000000 c 6.000000 0.000000 6.000000 -10.000000 0.000000 -10.000000 Z" fill="black" stroke="black" stroke-width="0"/>)"
+		R"(<path d="M 250.000000 245.000000 c -6.000000 0.000000 -6.000000 10.000000 0.000000 10.000000 l 100.000000 0.000000 c 6.000000 0.000000 6.000000 -10.000000 0.000000 -10.000000 Z" fill="black" stroke="black" stroke-width="0"/>)"
+		R"(<path d="M 250.000000 45.000000 c -6.000000 0.000000 -6.000000 10.000000 0.000000 10.000000 l 100.000000 0.000000 c 6.000000 0.000000 6.000000 -10.000000 0.000000 -10.000000 Z" fill="black" stroke="black" stroke-width="0"/>)"
+		R"(<path d="M 45.000000 250.000000 c 0.000000 6.000000 10.000000 6.000000 10.000000 0.000000 l 0.000000 -100.000000 c 0.000000 -6.000000 -10.000000 -6.000000 -10.000000 0.000000 Z" fill="black" stroke="black" stroke-width="0"/>)"
+		R"(<path d="M 45.000000 150.000000 c 0.000000 6.000000 10.000000 6.000000 10.000000 0.000000 l 0.000000 -100.000000 c 0.000000 -6.000000 -10.000000 -6.000000 -10.000000 0.000000 Z" fill="black" stroke="black" stroke-width="0"/>)"
+		R"(<path d="M 145.000000 250.000000 c 0.000000 6.000000 10.000000 6.000000 10.000000 0.000000 l 0.000000 -100.000000 c 0.000000 -6.000000 -10.000000 -6.000000 -10.000000 0.000000 Z" fill="black" stroke="black" stroke-width="0"/>)"
+		R"(<path d="M 345.000000 250.000000 c 0.000000 6.000000 10.000000 6.000000 10.000000 0.000000 l 0.000000 -100.000000 c 0.000000 -6.000000 -10.000000 -6.000000 -10.000000 0.000000 Z" fill="black" stroke="black" stroke-width="0"/>)"
+		R"(<path d="M 345.000000 150.000000 c 0.000000 6.000000 10.000000 6.000000 10.000000 0.000000 l 0.000000 -100.000000 c 0.000000 -6.000000 -10.000000 -6.000000 -10.000000 0.000000 Z" fill="black" stroke="black" stroke-width="0"/>)"
+		R"(<path d="M 65.000000 235.000000 l 70.000000 0.000000 l 0.000000 -10.500000 c -35.000000 0.000000 -35.000000 0.000000 -28.000000 -21.000000 a 21.000000 14.000000 -50.000000 1 0 -14.000000 -17.500000 l -23.100000 -10.500000 l 22.400000 17.500000 Z" fill="#f4191c" stroke="black" stroke-width="1.500000"/>)"
+		R"(<path d="M 111.200000 181.100000 a 2.800000 2.100000 -10.000000 1 0 0.200000 0.200000 Z" fill="white" stroke="black" stroke-width="1.500000"/>)"
+		R"(<path d="M 265.000000 235.000000 l 70.000000 0.000000 l 0.000000 -10.500000 c -35.000000 0.000000 -35.000000 0.000000 -28.000000 -21.000000 a 21.000000 14.000000 -50.000000 1 0 -14.000000 -17.500000 l -23.100000 -10.500000 l 22.400000 17.500000 Z" fill="#ffbd02" stroke="black" stroke-width="1.500000"/>)"
+		R"(<path d="M 311.200000 181.100000 a 2.800000 2.100000 -10.000000 1 0 0.200000 0.200000 Z" fill="white" stroke="black" stroke-width="1.500000"/>)"
+		R"(<path d="M 65.000000 135.000000 l 70.000000 0.000000 l 0.000000 -10.500000 c -35.000000 0.000000 -35.000000 0.000000 -28.000000 -21.000000 a 21.000000 14.000000 -50.000000 1 0 -14.000000 -17.500000 l -23.100000 -10.500000 l 22.400000 17.500000 Z" fill="#00a340" stroke="black" stroke-width="1.500000"/>)"
+		R"(<path d="M 111.200000 81.100000 a 2.800000 2.100000 -10.000000 1 0 0.200000 0.200000 Z" fill="white" stroke="black" stroke-width="1.500000"/>)"
+		R"(<path d="M 265.000000 135.000000 l 70.000000 0.000000 l 0.000000 -10.500000 c -35.000000 0.000000 -35.000000 0.000000 -28.000000 -21.000000 a 21.000000 14.000000 -50.000000 1 0 -14.000000 -17.500000 l -23.100000 -10.500000 l 22.400000 17.500000 Z" fill="#4285f4" stroke="black" stroke-width="1.500000"/>)"
+		R"(<path d="M 311.200000 81.100000 a 2.800000 2.100000 -10.000000 1 0 0.200000 0.200000 Z" fill="white" stroke="black" stroke-width="1.500000"/>)"
+		R"(</svg>)"
+	};
+
+	EXPECT_EQ(graphics::draw_tobor_world(world, positions, cell_id_type::create_by_coordinates(1, 1, world), coloring, graphics::piece_shape_selection::DUCK), expected);
+}
+
+TEST(svg, benchmark_renders_full_board) {
+	const auto results{ SvgBenchmark<tobor::v1_1::default_pieces_quantity>::run(5, 8793, 1, 1) };
+
+	ASSERT_EQ(results.size(), 2);
+	for (const auto& r : results) {
+		EXPECT_GT(r.document_bytes, 0);
+		EXPECT_GT(r.renders_per_second(), 0);
+	}
+}
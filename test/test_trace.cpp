@@ -0,0 +1,176 @@
+#include "gtest/gtest.h"
+
+#include "../src/trace.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(trace, ring_buffer_keeps_most_recent_events) {
+	using tobor::trace::thread_buffer;
+
+	const auto buffer{ std::make_unique<thread_buffer>(1) }; // too large for the stack
+
+	static constexpr std::size_t COUNT_OVERWRITTEN{ 10 };
+
+	for (std::size_t i{ 0 }; i < thread_buffer::CAPACITY + COUNT_OVERWRITTEN; ++i) {
+		buffer->record("counter", 'C', static_cast<int64_t>(i));
+	}
+
+	std::vector<tobor::trace::event> events;
+	buffer->copy_events(events);
+
+	ASSERT_EQ(events.size(), thread_buffer::CAPACITY);
+	EXPECT_EQ(events.front().value, static_cast<int64_t>(COUNT_OVERWRITTEN));
+	EXPECT_EQ(events.back().value, static_cast<int64_t>(thread_buffer::CAPACITY + COUNT_OVERWRITTEN - 1));
+
+	buffer->clear();
+	events.clear();
+	buffer->copy_events(events);
+	EXPECT_TRUE(events.empty());
+}
+
+TEST(trace, writes_chrome_trace_of_all_threads) {
+	auto& registry{ tobor::trace::registry::instance() };
+	registry.clear();
+
+	{
+		const tobor::trace::scoped_span outer("test::outer");
+		tobor::trace::registry::local_buffer().record("test::counter", 'C', 42);
+	}
+	std::thread([]() { const tobor::trace::scoped_span span("test::other_thread"); }).join();
+
+	std::stringstream out;
+	registry.write_chrome_trace(out);
+
+	const nlohmann::json trace = nlohmann::json::parse(out.str());
+	const auto& events{ trace.at("traceEvents") };
+
+	ASSERT_EQ(events.size(), 5);
+
+	std::set<int64_t> thread_ids;
+	for (const auto& e : events) {
+		thread_ids.insert(e.at("tid").get<int64_t>());
+		if (e.at("ph") == "C") {
+			EXPECT_EQ(e.at("name"), "test::counter");
+			EXPECT_EQ(e.at("args").at("value"), 42);
+		}
+	}
+	EXPECT_EQ(thread_ids.size(), 2);
+
+	std::vector<nlohmann::json> outer_events;
+	std::copy_if(events.cbegin(), events.cend(), std::back_inserter(outer_events), [](const nlohmann::json& e) { return e.at("name") == "test::outer"; });
+	ASSERT_EQ(outer_events.size(), 2);
+	EXPECT_EQ(outer_events[0].at("ph"), "B");
+	EXPECT_EQ(outer_events[1].at("ph"), "E");
+	EXPECT_LE(outer_events[0].at("ts").get<double>(), outer_events[1].at("ts").get<double>());
+}
+
+TEST(trace, copies_consistent_events_while_recording) {
+	using tobor::trace::thread_buffer;
+
+	const auto buffer{ std::make_unique<thread_buffer>(1) };
+
+	static constexpr int64_t COUNT_RECORDED{ 4 * thread_buffer::CAPACITY };
+
+	std::thread producer([&buffer]() {
+		for (int64_t i{ 0 }; i < COUNT_RECORDED; ++i) {
+			buffer->record("counter", 'C', i);
+		}
+	});
+
+	std::vector<tobor::trace::event> events;
+	for (int round{ 0 }; round < 16; ++round) {
+		events.clear();
+		buffer->copy_events(events);
+		for (std::size_t i{ 1 }; i < events.size(); ++i) {
+			ASSERT_LT(events[i - 1].value, events[i].value);
+			ASSERT_LE(events[i - 1].timestamp_ns, events[i].timestamp_ns);
+		}
+		for (const auto& e : events) {
+			ASSERT_EQ(e.phase, 'C');
+			ASSERT_EQ(std::string(e.name), "counter");
+		}
+	}
+	producer.join();
+
+	events.clear();
+	buffer->copy_events(events);
+	ASSERT_EQ(events.size(), thread_buffer::CAPACITY);
+	EXPECT_EQ(events.back().value, COUNT_RECORDED - 1);
+}
+
+TEST(trace, clears_while_recording) {
+	using tobor::trace::thread_buffer;
+
+	const auto buffer{ std::make_unique<thread_buffer>(1) };
+
+	static constexpr int64_t COUNT_RECORDED{ 4 * thread_buffer::CAPACITY };
+
+	std::thread producer([&buffer]() {
+		for (int64_t i{ 0 }; i < COUNT_RECORDED; ++i) {
+			buffer->record("counter", 'C', i);
+		}
+	});
+
+	std::vector<tobor::trace::event> events;
+	for (int round{ 0 }; round < 64; ++round) {
+		buffer->clear();
+		events.clear();
+		buffer->copy_events(events);
+		for (std::size_t i{ 1 }; i < events.size(); ++i) {
+			ASSERT_LT(events[i - 1].value, events[i].value);
+		}
+	}
+	producer.join();
+
+	events.clear();
+	buffer->copy_events(events);
+	ASSERT_FALSE(events.empty());
+	EXPECT_EQ(events.back().value, COUNT_RECORDED - 1);
+
+	buffer->clear();
+	buffer->record("counter", 'C', COUNT_RECORDED);
+	events.clear();
+	buffer->copy_events(events);
+	ASSERT_EQ(events.size(), std::size_t(1));
+	EXPECT_EQ(events.front().value, COUNT_RECORDED);
+}
+
+TEST(trace, recycles_buffers_of_exited_threads) {
+	auto& registry{ tobor::trace::registry::instance() };
+	registry.clear();
+
+	tobor::trace::registry::local_buffer(); // buffer of this thread
+	const std::size_t count_buffers{ registry.count_buffers() };
+
+	static constexpr int64_t COUNT_THREADS{ 8 };
+
+	for (int64_t i{ 0 }; i < COUNT_THREADS; ++i) {
+		std::thread([i]() { tobor::trace::registry::local_buffer().record("test::exited_thread", 'C', i); }).join();
+	}
+	EXPECT_LE(registry.count_buffers(), count_buffers + 1);
+
+	std::stringstream out;
+	registry.write_chrome_trace(out);
+
+	const nlohmann::json trace = nlohmann::json::parse(out.str());
+
+	std::vector<int64_t> values;
+	for (const auto& e : trace.at("traceEvents")) {
+		if (e.at("name") == "test::exited_thread") {
+			values.push_back(e.at("args").at("value").get<int64_t>());
+		}
+	}
+	ASSERT_EQ(values.size(), static_cast<std::size_t>(COUNT_THREADS));
+	for (int64_t i{ 0 }; i < COUNT_THREADS; ++i) {
+		EXPECT_EQ(values[i], i);
+	}
+}